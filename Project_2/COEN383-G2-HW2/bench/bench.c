@@ -0,0 +1,238 @@
+// Scheduler microbenchmark: times every registered policy on synthetic
+// workloads from 40 to 10^6 processes and reports ns per engine event,
+// heap allocations per run and peak RSS. Each (policy, size) case runs in a
+// forked child so its peak RSS is its own. Build from COEN383-G2-HW2:
+//
+//   gcc -O2 -pthread -I. -o sched_bench bench/bench.c $(ls *.c | grep -v '^main.c$') -lm
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include "process.h"
+#include "policies.h"
+#include "rng.h"
+
+// Count heap allocations by wrapping glibc's allocator; elsewhere the
+// allocation column reads -1
+#ifdef __GLIBC__
+#define COUNTS_ALLOCATIONS 1
+
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t count, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+extern void __libc_free(void *ptr);
+
+static long allocations = 0;
+
+void *malloc(size_t size) {
+    allocations++;
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size) {
+    allocations++;
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *ptr, size_t size) {
+    allocations++;
+    return __libc_realloc(ptr, size);
+}
+
+void free(void *ptr) {
+    __libc_free(ptr);
+}
+#else
+static long allocations = -1;
+#endif
+
+static const int bench_sizes[] = {40, 100, 1000, 10000, 100000, 1000000};
+
+#define NUM_BENCH_SIZES (int)(sizeof(bench_sizes) / sizeof(bench_sizes[0]))
+
+typedef struct {
+    long iterations;
+    double ns_per_event;
+    double events_per_run;
+    double allocations_per_run;
+    int completed;          // Jobs finished by the fewest-finishing run; a case only counts if all n did
+} CaseResult;
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Same job mix as generate_workload (bursts 0.1-10, priorities 1-4), but with
+// arrivals spread over n * 5.5 quanta so the CPU stays about 90% busy at any n
+static void bench_workload(Process processes[], int n, uint64_t seed) {
+    Rng rng;
+    rng_seed(&rng, seed);
+
+    for (int i = 0; i < n; i++) {
+        double arrival = floor(rng_double(&rng) * n * 5.5);
+        double service = rng_below(&rng, 100) / 10.0 + 0.1;
+        init_process(&processes[i], i, arrival, service, rng_below(&rng, 4) + 1);
+    }
+    sort_by_arrival(processes, n);
+}
+
+// Repeat the run until min_time has been spent inside sim_run, after one
+// untimed warm-up. Each run includes resetting the table's run columns, as
+// it does for every policy in the simulator.
+static CaseResult run_case(const PolicyInfo *policy, int n, double min_time) {
+    Process *original = (Process *)malloc(sizeof(Process) * n);
+    bench_workload(original, n, 42);
+
+    ProcTable table;
+    proc_table_init(&table, n);
+    proc_table_load(&table, original);
+    Metrics warmup = sim_run(&table, policy->ops, NULL).overall;
+
+    CaseResult r = {0, 0.0, 0.0, 0.0, (int)warmup.throughput};
+    double elapsed = 0.0;
+    double events = 0.0;
+    long allocs = 0;
+
+    while (elapsed < min_time || r.iterations == 0) {
+        long allocs_before = allocations;
+        double start = now_seconds();
+        Metrics m = sim_run(&table, policy->ops, NULL).overall;
+        elapsed += now_seconds() - start;
+        allocs += allocations - allocs_before;
+
+        events += m.events;
+        r.iterations++;
+        if (m.throughput < r.completed) r.completed = (int)m.throughput;
+    }
+
+    r.ns_per_event = (events > 0) ? elapsed * 1e9 / events : 0.0;
+    r.events_per_run = events / r.iterations;
+    r.allocations_per_run = (allocations < 0) ? -1.0 : (double)allocs / r.iterations;
+
+    free(original);
+    proc_table_free(&table);
+    return r;
+}
+
+// Run one case in a child process; returns 0 if the child failed
+static int run_case_isolated(const PolicyInfo *policy, int n, double min_time,
+                             CaseResult *result, long *peak_rss_kb) {
+    int fds[2];
+    if (pipe(fds) != 0) return 0;
+
+    fflush(stdout);
+    pid_t child = fork();
+    if (child < 0) return 0;
+
+    if (child == 0) {
+        close(fds[0]);
+        CaseResult r = run_case(policy, n, min_time);
+        ssize_t written = write(fds[1], &r, sizeof(r));
+        _exit(written == (ssize_t)sizeof(r) ? 0 : 1);
+    }
+
+    close(fds[1]);
+    ssize_t got = read(fds[0], result, sizeof(*result));
+    close(fds[0]);
+
+    int status;
+    struct rusage usage;
+    if (wait4(child, &status, 0, &usage) < 0) return 0;
+
+#ifdef __APPLE__
+    *peak_rss_kb = usage.ru_maxrss / 1024;  // Bytes on macOS
+#else
+    *peak_rss_kb = usage.ru_maxrss;
+#endif
+
+    return got == (ssize_t)sizeof(*result) && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+static void print_usage(const char *prog) {
+    printf("Usage: %s [--max <n>] [--min-time <seconds>] [--policies <list>]\n", prog);
+    printf("  --max <n>               Largest process count to run (default 1000000)\n");
+    printf("  --min-time <seconds>    Timed runtime per case (default 0.5)\n");
+    printf("  --policies <list>       Comma-separated policies to run (default: all)\n");
+}
+
+int main(int argc, char *argv[]) {
+    int max_n = 1000000;
+    double min_time = 0.5;
+    const char *policy_list = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--max") == 0 && i + 1 < argc) {
+            max_n = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) {
+            min_time = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--policies") == 0 && i + 1 < argc) {
+            policy_list = argv[++i];
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    // Every job should run, however long the trace
+    sched_config.start_cutoff = HUGE_VAL;
+
+    const PolicyInfo **policies = (const PolicyInfo **)malloc(sizeof(PolicyInfo *) * num_registered_policies);
+    int num_policies = 0;
+
+    if (policy_list == NULL) {
+        for (int p = 0; p < num_registered_policies; p++) policies[num_policies++] = &policy_registry[p];
+    } else {
+        char *copy = strdup(policy_list);
+        for (char *name = strtok(copy, ","); name != NULL; name = strtok(NULL, ",")) {
+            const PolicyInfo *policy = find_policy(name);
+            if (policy == NULL) {
+                printf("Error: unknown policy %s\n", name);
+                return 1;
+            }
+            if (num_policies < num_registered_policies) policies[num_policies++] = policy;
+        }
+        free(copy);
+    }
+
+    int failed = 0;
+    printf("%-16s %9s %8s %10s %12s %11s %10s\n",
+           "benchmark", "n", "iters", "ns/event", "events/run", "allocs/run", "peak RSS");
+
+    for (int p = 0; p < num_policies; p++) {
+        const PolicyInfo *policy = policies[p];
+
+        for (int s = 0; s < NUM_BENCH_SIZES && bench_sizes[s] <= max_n; s++) {
+            int n = bench_sizes[s];
+            CaseResult r;
+            long peak_rss_kb;
+            char label[32];
+            snprintf(label, sizeof(label), "%s/%d", policy->name, n);
+
+            if (!run_case_isolated(policy, n, min_time, &r, &peak_rss_kb)) {
+                printf("%-16s %9d  failed\n", label, n);
+                failed++;
+                continue;
+            }
+            if (r.completed != n) {
+                // Timing a run that stopped early would understate the work
+                printf("%-16s %9d  failed: only %d of %d jobs completed\n", label, n, r.completed, n);
+                failed++;
+                continue;
+            }
+
+            printf("%-16s %9d %8ld %10.1f %12.0f %11.1f %7.1f MB\n",
+                   label, n, r.iterations, r.ns_per_event, r.events_per_run,
+                   r.allocations_per_run, peak_rss_kb / 1024.0);
+        }
+    }
+
+    free(policies);
+    return failed > 0;
+}
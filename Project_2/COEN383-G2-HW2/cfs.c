@@ -0,0 +1,104 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "process.h"
+#include "sim_engine.h"
+#include "policies.h"
+#include "ready_queue.h"
+
+// Completely-fair style scheduler: always run the process with the least
+// virtual runtime, where virtual runtime grows more slowly for higher
+// priorities. Slices split a target latency between everything runnable,
+// but never drop below a minimum granularity.
+
+#define CFS_TARGET_LATENCY 6.0
+#define CFS_MIN_GRANULARITY 1.0
+#define CFS_NICE_0_WEIGHT 1024.0
+
+#define CFS_COUNTER_SLICES 0
+#define CFS_COUNTER_PREEMPTIONS 1
+
+// Linux load weights for nice -3 .. 0, used for priority 1 .. 4
+static const double cfs_weights[4] = {1991.0, 1586.0, 1277.0, 1024.0};
+
+typedef struct {
+    Sim *sim;
+    ReadyHeap ready;     // Runnable processes keyed on vruntime
+    double *vruntime;
+    double *slice;       // Slice pid was last given, charged to vruntime on preempt
+    double min_vruntime; // Never decreases; new arrivals start here
+} CFSState;
+
+static void *cfs_init(Sim *sim) {
+    int n = (sim->num_processes > 0) ? sim->num_processes : 1;
+    CFSState *s = (CFSState *)malloc(sizeof(CFSState));
+    s->sim = sim;
+    ready_heap_init(&s->ready, n);
+    s->vruntime = (double *)malloc(sizeof(double) * n);
+    s->slice = (double *)malloc(sizeof(double) * n);
+    s->min_vruntime = 0.0;
+    return s;
+}
+
+static void cfs_destroy(void *state) {
+    CFSState *s = (CFSState *)state;
+    ready_heap_free(&s->ready);
+    free(s->vruntime);
+    free(s->slice);
+    free(s);
+}
+
+static void cfs_on_arrival(void *state, int pid) {
+    CFSState *s = (CFSState *)state;
+
+    // Start level with the least-served runnable process rather than at 0,
+    // which would let a newcomer monopolise the CPU
+    s->vruntime[pid] = s->min_vruntime;
+    ready_heap_push(&s->ready, s->vruntime[pid], pid);
+}
+
+static int cfs_pick_next(void *state) {
+    CFSState *s = (CFSState *)state;
+
+    while (!ready_heap_empty(&s->ready)) {
+        int pid = ready_heap_pop(&s->ready);
+        if (s->vruntime[pid] > s->min_vruntime) s->min_vruntime = s->vruntime[pid];
+
+        // Don't start new process after the cutoff (quantum 99 by default), like RR
+        if (sim_too_late(s->sim, pid)) continue;
+
+        return pid;
+    }
+
+    return SIM_IDLE;
+}
+
+static void cfs_on_preempt(void *state, int pid) {
+    CFSState *s = (CFSState *)state;
+
+    s->vruntime[pid] += s->slice[pid] * CFS_NICE_0_WEIGHT / cfs_weights[s->sim->table->priority[pid] - 1];
+    ready_heap_push(&s->ready, s->vruntime[pid], pid);
+    s->sim->counters[CFS_COUNTER_PREEMPTIONS]++;
+}
+
+static double cfs_quantum_of(void *state, int pid) {
+    CFSState *s = (CFSState *)state;
+
+    // The picked process counts as runnable too
+    double slice = CFS_TARGET_LATENCY / (s->ready.size + 1);
+    if (slice < CFS_MIN_GRANULARITY) slice = CFS_MIN_GRANULARITY;
+
+    s->slice[pid] = slice;
+    s->sim->counters[CFS_COUNTER_SLICES]++;
+    return slice;
+}
+
+const SchedOps cfs_ops = {
+    .quantum = 1.0,
+    .init = cfs_init,
+    .destroy = cfs_destroy,
+    .on_arrival = cfs_on_arrival,
+    .pick_next = cfs_pick_next,
+    .on_preempt = cfs_on_preempt,
+    .quantum_of = cfs_quantum_of,
+};
@@ -1,72 +1,69 @@
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include "process.h"
+#include "sim_engine.h"
+#include "policies.h"
+#include "ready_queue.h"
 
-Metrics fcfs(Process processes[], int num_processes, char (*timeline)[10])
+typedef struct
 {
-    double current_time = 0.0;
-    int completed = 0;
+    Sim *sim;
+    FifoRing ready; // Arrived processes that have not run yet, oldest first
+} FCFSState;
 
-    // While there are uncompleted processes
-    while (completed < num_processes)
-    {
-        int next_process = -1; // Index of next process to execute (-1 if none)
-
-        // Find next process that has arrived and not completed
-        for (int i = 0; i < num_processes; i++)
-        {
-            if (!processes[i].completed &&
-                processes[i].arrival_time <= current_time) // FCFS: pick the first arrived
-            {
-                next_process = i;
-                break;
-            }
-        }
+static void *fcfs_init(Sim *sim)
+{
+    FCFSState *s = (FCFSState *)malloc(sizeof(FCFSState));
+    s->sim = sim;
+    fifo_ring_init(&s->ready, sim->num_processes);
+    return s;
+}
 
-        if (next_process != -1)
-        {
-            Process *p = &processes[next_process]; // Pointer to the selected process because we will modify it
+static void fcfs_destroy(void *state)
+{
+    FCFSState *s = (FCFSState *)state;
+    fifo_ring_free(&s->ready);
+    free(s);
+}
 
-            // Don't start new process after quantum 99
-            if (current_time > 99.0)
-            {
-                break;
-            }
+static void fcfs_on_arrival(void *state, int pid)
+{
+    FCFSState *s = (FCFSState *)state;
+    fifo_ring_push(&s->ready, pid);
+}
 
-            // Record start time if first run
-            if (p->start_time < 0.0)
-            {
-                p->start_time = current_time;
-                p->response_time = current_time - p->arrival_time;
-            }
+static int fcfs_pick_next(void *state)
+{
+    FCFSState *s = (FCFSState *)state;
 
-            // Execute the process completely
-            current_time += p->service_time;
-            p->finish_time = current_time;
-            p->turnaround_time = p->finish_time - p->arrival_time;
-            p->wait_time = p->turnaround_time - p->service_time;
-            p->completed = 1;
-            completed++;
-        }
-        else
-        {
-            // No process ready, advance time
-            current_time += 1.0;
+    if (fifo_ring_empty(&s->ready))
+    {
+        return SIM_IDLE;
+    }
 
-            // Check if we should stop because no future processes will arrive
-            int has_future = 0;
-            for (int i = 0; i < num_processes; i++)
-            {
-                if (!processes[i].completed && processes[i].arrival_time > current_time)
-                {
-                    has_future = 1;
-                    break;
-                }
-            }
-            if (!has_future)
-                break;
-        }
+    // Don't start new process after the cutoff (quantum 99 by default)
+    if (sim_too_late(s->sim, fifo_ring_peek(&s->ready)))
+    {
+        return SIM_STOP;
     }
 
-    return calculate_metrics(processes, num_processes);
-}
\ No newline at end of file
+    return fifo_ring_pop(&s->ready); // FCFS: pick the first arrived, it runs to completion
+}
+
+static void fcfs_on_preempt(void *state, int pid)
+{
+    // Non-preemptive
+    (void)state;
+    (void)pid;
+}
+
+const SchedOps fcfs_ops = {
+    .quantum = 0.0,
+    .init = fcfs_init,
+    .destroy = fcfs_destroy,
+    .on_arrival = fcfs_on_arrival,
+    .pick_next = fcfs_pick_next,
+    .on_preempt = fcfs_on_preempt,
+    .quantum_of = NULL,
+};
@@ -0,0 +1,78 @@
+#include <math.h>
+#include "histogram.h"
+
+static int bucket_index(uint64_t v) {
+    if (v < 2 * HIST_SUB_BUCKETS) return (int)v;
+
+    int shift = 63 - __builtin_clzll(v) - 6;
+    if (shift > HIST_MAX_SHIFT) return HIST_BUCKETS - 1;
+    return shift * HIST_SUB_BUCKETS + (int)(v >> shift);
+}
+
+// Largest value (in hundredths) that lands in bucket idx
+static uint64_t bucket_highest(int idx) {
+    if (idx < 2 * HIST_SUB_BUCKETS) return (uint64_t)idx;
+
+    int shift = idx / HIST_SUB_BUCKETS - 1;
+    uint64_t top = (uint64_t)(idx % HIST_SUB_BUCKETS + HIST_SUB_BUCKETS);
+    return ((top + 1) << shift) - 1;
+}
+
+void histogram_record(Histogram *h, double value) {
+    // Float slop can leave a wait a hair below zero
+    if (value < 0.0) value = 0.0;
+
+    h->counts[bucket_index((uint64_t)(value * 100.0 + 0.5))]++;
+    if (h->total == 0 || value > h->max) h->max = value;
+    h->total++;
+}
+
+// Nearest-rank percentile, reported as the top of its bucket (never above max)
+double histogram_percentile(const Histogram *h, double pct) {
+    if (h->total == 0) return 0.0;
+
+    uint64_t rank = (uint64_t)ceil(pct / 100.0 * h->total);
+    if (rank < 1) rank = 1;
+
+    uint64_t seen = 0;
+    for (int i = 0; i < HIST_BUCKETS; i++) {
+        seen += h->counts[i];
+        if (seen >= rank) {
+            double value = bucket_highest(i) / 100.0;
+            return (value < h->max) ? value : h->max;
+        }
+    }
+    return h->max;
+}
+
+void latency_stats_record(LatencyStats *s, int priority, double turnaround, double wait, double response) {
+    int rows[2] = {0, priority};
+
+    for (int r = 0; r < 2; r++) {
+        histogram_record(&s->hist[rows[r]][LAT_TURNAROUND], turnaround);
+        histogram_record(&s->hist[rows[r]][LAT_WAIT], wait);
+        histogram_record(&s->hist[rows[r]][LAT_RESPONSE], response);
+    }
+}
+
+static Percentiles percentiles_of(const Histogram *h) {
+    Percentiles p;
+    p.p50 = histogram_percentile(h, 50.0);
+    p.p95 = histogram_percentile(h, 95.0);
+    p.p99 = histogram_percentile(h, 99.0);
+    p.max = (h->total > 0) ? h->max : 0.0;
+    return p;
+}
+
+static void fill_metrics(const Histogram hist[NUM_LATENCIES], Metrics *m) {
+    m->turnaround_pct = percentiles_of(&hist[LAT_TURNAROUND]);
+    m->wait_pct = percentiles_of(&hist[LAT_WAIT]);
+    m->response_pct = percentiles_of(&hist[LAT_RESPONSE]);
+}
+
+void latency_stats_fill(const LatencyStats *s, HPFMetrics *hm) {
+    fill_metrics(s->hist[0], &hm->overall);
+    for (int p = 0; p < 4; p++) {
+        fill_metrics(s->hist[p + 1], &hm->priority[p]);
+    }
+}
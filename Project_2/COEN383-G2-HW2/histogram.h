@@ -0,0 +1,35 @@
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+#include <stdint.h>
+#include "process.h"
+
+// Log-linear latency histogram (HDR style). Values are kept in hundredths of
+// a quantum: exact below 1.28, then 64 buckets per power of two (about 1.6%
+// relative error) up to 2^40 hundredths. Memory is fixed at HIST_BUCKETS
+// counters however many values are recorded.
+#define HIST_SUB_BUCKETS 64
+#define HIST_MAX_SHIFT 34
+#define HIST_BUCKETS ((HIST_MAX_SHIFT + 2) * HIST_SUB_BUCKETS)
+
+typedef struct {
+    uint32_t counts[HIST_BUCKETS];
+    uint64_t total;
+    double max;  // Exact, not bucketed
+} Histogram;
+
+void histogram_record(Histogram *h, double value);
+double histogram_percentile(const Histogram *h, double pct);
+
+enum { LAT_TURNAROUND, LAT_WAIT, LAT_RESPONSE, NUM_LATENCIES };
+
+// One histogram per latency kind, for all processes ([0]) and per priority ([1..4])
+typedef struct {
+    Histogram hist[5][NUM_LATENCIES];
+} LatencyStats;
+
+void latency_stats_record(LatencyStats *s, int priority, double turnaround, double wait, double response);
+// Fill the percentile fields of every Metrics in hm
+void latency_stats_fill(const LatencyStats *s, HPFMetrics *hm);
+
+#endif
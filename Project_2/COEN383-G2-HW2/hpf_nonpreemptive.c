@@ -1,68 +1,65 @@
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include "process.h"
+#include "sim_engine.h"
+#include "policies.h"
+#include "ready_queue.h"
 
-HPFMetrics hpf_nonpreemptive(Process processes[], int num_processes, char (*timeline)[10]) {
-    double current_time = 0.0;
-    int completed = 0;
-    
-    while (completed < num_processes) {
-        int next_process = -1;
-        int highest_priority = 5;
-        
-        // Find highest priority process (lower number = higher priority)
-        for (int i = 0; i < num_processes; i++) {
-            if (!processes[i].completed && 
-                processes[i].arrival_time <= current_time) {
-                if (processes[i].priority < highest_priority) {
-                    highest_priority = processes[i].priority;
-                    next_process = i;
-                } else if (processes[i].priority == highest_priority && next_process != -1) {
-                    // FCFS tiebreaker within same priority
-                    if (processes[i].arrival_time < processes[next_process].arrival_time ||
-                        (processes[i].arrival_time == processes[next_process].arrival_time && i < next_process)) {
-                        next_process = i;
-                    }
-                }
-            }
-        }
-        
-        if (next_process != -1) {
-            Process *p = &processes[next_process];
-            
-            // Don't start new process after quantum 99
-            if (current_time > 99.0) {
-                break;
-            }
-            
-            // Record start time if first run
-            if (p->start_time < 0.0) {
-                p->start_time = current_time;
-                p->response_time = current_time - p->arrival_time;
-            }
-            
-            // Execute the process completely (non-preemptive)
-            current_time += p->service_time;
-            p->finish_time = current_time;
-            p->turnaround_time = p->finish_time - p->arrival_time;
-            p->wait_time = p->turnaround_time - p->service_time;
-            p->completed = 1;
-            completed++;
-        } else {
-            // No process ready, advance time
-            current_time += 1.0;
-            
-            // Check if we should stop
-            int has_future = 0;
-            for (int i = 0; i < num_processes; i++) {
-                if (!processes[i].completed && processes[i].arrival_time > current_time) {
-                    has_future = 1;
-                    break;
-                }
-            }
-            if (!has_future) break;
-        }
+typedef struct {
+    Sim *sim;
+    PriorityRings ready;
+} HPFNPState;
+
+static void *hpf_np_init(Sim *sim) {
+    HPFNPState *s = (HPFNPState *)malloc(sizeof(HPFNPState));
+    s->sim = sim;
+    priority_rings_init(&s->ready, sim->num_processes);
+    return s;
+}
+
+static void hpf_np_destroy(void *state) {
+    HPFNPState *s = (HPFNPState *)state;
+    priority_rings_free(&s->ready);
+    free(s);
+}
+
+static void hpf_np_on_arrival(void *state, int pid) {
+    HPFNPState *s = (HPFNPState *)state;
+    priority_rings_push(&s->ready, s->sim->table->priority[pid] - 1, pid, s->sim->current_time);
+}
+
+static int hpf_np_pick_next(void *state) {
+    HPFNPState *s = (HPFNPState *)state;
+
+    if (sched_config.aging_interval > 0.0) {
+        priority_rings_age(&s->ready, s->sim->current_time, sched_config.aging_interval);
     }
-    
-    return calculate_hpf_metrics(processes, num_processes);
-}
\ No newline at end of file
+
+    if (priority_rings_empty(&s->ready)) return SIM_IDLE;
+
+    // Highest priority level first (lower number = higher priority), FCFS within the level
+    int level = priority_rings_top(&s->ready);
+
+    // Don't start new process after the cutoff (quantum 99 by default)
+    if (sim_too_late(s->sim, priority_rings_head(&s->ready, level))) return SIM_STOP;
+
+    return priority_rings_pop(&s->ready, level);
+}
+
+static void hpf_np_on_preempt(void *state, int pid) {
+    // Non-preemptive
+    (void)state;
+    (void)pid;
+}
+
+// Execute the process completely (non-preemptive)
+const SchedOps hpf_np_ops = {
+    .quantum = 0.0,
+    .init = hpf_np_init,
+    .destroy = hpf_np_destroy,
+    .on_arrival = hpf_np_on_arrival,
+    .pick_next = hpf_np_pick_next,
+    .on_preempt = hpf_np_on_preempt,
+    .quantum_of = NULL,
+};
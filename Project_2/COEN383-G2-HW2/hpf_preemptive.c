@@ -1,99 +1,69 @@
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include "process.h"
+#include "sim_engine.h"
+#include "policies.h"
+#include "ready_queue.h"
 
-HPFMetrics hpf_preemptive(Process processes[], int num_processes, char (*timeline)[10]) {
-    double current_time = 0.0;
-    int completed = 0;
-    int last_process_index[4] = {-1, -1, -1, -1};
-    
-    while (completed < num_processes) {
-        int next_process = -1;
-        int highest_priority = 5;
-        
-        // Find highest priority process
-        for (int i = 0; i < num_processes; i++) {
-            if (!processes[i].completed && 
-                processes[i].arrival_time <= current_time &&
-                processes[i].priority < highest_priority) {
-                highest_priority = processes[i].priority;
-            }
-        }
-        
-        if (highest_priority < 5) {
-            // Use Round Robin within this priority level
-            int priority_idx = highest_priority - 1;
-            int start_idx = (last_process_index[priority_idx] + 1) % num_processes;
-            int checked = 0;
-            
-            while (checked < num_processes) {
-                int i = (start_idx + checked) % num_processes;
-                
-                if (!processes[i].completed && 
-                    processes[i].arrival_time <= current_time &&
-                    processes[i].priority == highest_priority) {
-                    next_process = i;
-                    last_process_index[priority_idx] = i;
-                    break;
-                }
-                checked++;
-            }
-        }
-        
-        if (next_process != -1) {
-            Process *p = &processes[next_process];
-            
-            // Don't start new process after quantum 99
-            if (p->start_time < 0.0 && current_time > 99.0) {
-                last_process_index[p->priority - 1] = next_process;
-                
-                // Try to find another process that already started
-                int found_other = 0;
-                for (int i = 0; i < num_processes; i++) {
-                    if (!processes[i].completed && 
-                        processes[i].arrival_time <= current_time &&
-                        processes[i].start_time >= 0.0) {
-                        found_other = 1;
-                        break;
-                    }
-                }
-                if (!found_other) break;
-            }
-            
-            // Record start time on first run
-            if (p->start_time < 0.0) {
-                p->start_time = current_time;
-                p->response_time = current_time - p->arrival_time;
-            }
-            
-            // Execute for 1 quantum (preemptive RR)
-            double exec_time = (p->remaining_time < 1.0) ? p->remaining_time : 1.0;
-            current_time += exec_time;
-            p->remaining_time -= exec_time;
-            
-            // Check if completed
-            if (p->remaining_time < 0.01) {
-                p->finish_time = current_time;
-                p->turnaround_time = p->finish_time - p->arrival_time;
-                p->wait_time = p->turnaround_time - p->service_time;
-                p->completed = 1;
-                completed++;
-            }
-        } else {
-            // No process ready, advance time
-            current_time += 1.0;
-            
-            // Check if we should stop
-            int has_future = 0;
-            for (int i = 0; i < num_processes; i++) {
-                if (!processes[i].completed && processes[i].arrival_time > current_time) {
-                    has_future = 1;
-                    break;
-                }
-            }
-            if (!has_future) break;
-        }
+typedef struct {
+    Sim *sim;
+    PriorityRings ready;
+} HPFPState;
+
+static void *hpf_p_init(Sim *sim) {
+    HPFPState *s = (HPFPState *)malloc(sizeof(HPFPState));
+    s->sim = sim;
+    priority_rings_init(&s->ready, sim->num_processes);
+    return s;
+}
+
+static void hpf_p_destroy(void *state) {
+    HPFPState *s = (HPFPState *)state;
+    priority_rings_free(&s->ready);
+    free(s);
+}
+
+static void hpf_p_on_arrival(void *state, int pid) {
+    HPFPState *s = (HPFPState *)state;
+    priority_rings_push(&s->ready, s->sim->table->priority[pid] - 1, pid, s->sim->current_time);
+}
+
+static int hpf_p_pick_next(void *state) {
+    HPFPState *s = (HPFPState *)state;
+
+    if (sched_config.aging_interval > 0.0) {
+        priority_rings_age(&s->ready, s->sim->current_time, sched_config.aging_interval);
     }
-    
-    return calculate_hpf_metrics(processes, num_processes);
+
+    if (priority_rings_empty(&s->ready)) return SIM_IDLE;
+
+    // Round Robin within the highest non-empty priority level
+    int level = priority_rings_top(&s->ready);
+    int next_process = priority_rings_head(&s->ready, level);
+
+    // Don't start new process after the cutoff (quantum 99 by default), unless others already started are still running
+    if (sim_too_late(s->sim, next_process) && s->sim->in_progress == 0) {
+        return SIM_STOP;
+    }
+
+    return priority_rings_pop(&s->ready, level);
 }
+
+static void hpf_p_on_preempt(void *state, int pid) {
+    HPFPState *s = (HPFPState *)state;
+
+    // Back to the tail of the level it ran from
+    priority_rings_push(&s->ready, s->ready.level[pid], pid, s->sim->current_time);
+}
+
+// Execute for 1 quantum (preemptive RR)
+const SchedOps hpf_p_ops = {
+    .quantum = 1.0,
+    .init = hpf_p_init,
+    .destroy = hpf_p_destroy,
+    .on_arrival = hpf_p_on_arrival,
+    .pick_next = hpf_p_pick_next,
+    .on_preempt = hpf_p_on_preempt,
+    .quantum_of = NULL,
+};
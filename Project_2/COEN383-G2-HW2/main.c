@@ -1,238 +1,432 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
+#include <math.h>
 #include "process.h"
+#include "sweep.h"
+#include "timeline.h"
+#include "policies.h"
+#include "trace.h"
+#include "report.h"
+
+
+Report report;
+ReportFormat report_format = FORMAT_TEXT;
+int show_tables = 1;  // 0 = --no-tables: summaries only, no per-process rows
+
+// One character per quantum for the first 999 quanta; a quantum shared by
+// several processes shows the last one that ran in it. One line per core.
+void print_gantt_chart(const Timeline *tl, const Process processes[]) {
+    for (int core = 0; core < sched_config.num_cores; core++) {
+        char chart[1000];
+        memset(chart, '_', 999);
+        chart[999] = '\0';
+
+        int max_time = 0;
+
+        for (int i = 0; i < tl->count; i++) {
+            const Interval *iv = &tl->intervals[i];
+            if (iv->core != core) continue;
+
+            int start = (int)floor(iv->start);
+            int end = (int)ceil(iv->end);
 
-extern Metrics fcfs(Process processes[], int num_processes, char (*timeline)[10]);
-extern Metrics sjf(Process processes[], int num_processes, char (*timeline)[10]);
-extern Metrics srt(Process processes[], int num_processes, char (*timeline)[10]);
-extern Metrics round_robin(Process processes[], int num_processes, char (*timeline)[10]);
-extern HPFMetrics hpf_nonpreemptive(Process processes[], int num_processes, char (*timeline)[10]);
-extern HPFMetrics hpf_preemptive(Process processes[], int num_processes, char (*timeline)[10]);
-
-void print_gantt_chart(Process processes[], int num_processes) {
-    char chart[1000];
-    memset(chart, '_', 999);
-    chart[999] = '\0';
-
-    int max_time = 0;
-
-    for (int i = 0; i < num_processes; i++) {
-        if (processes[i].completed && processes[i].finish_time > 0) {
-            int start = (int)processes[i].start_time;
-            int end = (int)processes[i].finish_time;
-           
             for (int t = start; t < end && t < 999; t++) {
-                chart[t] = processes[i].name[0];
+                chart[t] = processes[iv->pid].name[0];
             }
             if (end > max_time) max_time = end;
         }
+       
+        if (max_time > 999) max_time = 999;
+        chart[max_time] = '\0';
+
+        if (sched_config.num_cores > 1) report_printf(&report, "CPU %d: ", core);
+        report_printf(&report, "%s\n", chart);
     }
-   
-    if (max_time > 999) max_time = 999;
-    chart[max_time] = '\0';
-   
-    printf("%s\n\n", chart);
+    report_write(&report, "\n", 1);
+}
+
+// Run-wide counters, only interesting with more than one core
+void print_core_stats(const Metrics *m) {
+    if (sched_config.num_cores == 1) return;
+
+    report_printf(&report, "Cores: %d  Utilization: %.1f%%  Context switches: %.0f  Steals: %.0f\n\n",
+                  sched_config.num_cores, m->utilization * 100.0, m->context_switches, m->steals);
 }
 
 void print_input_table(Process p[], int n) {
-    printf("process_name | arrival_time | burst_time | process_priority |\n");
-    for(int i=0; i<n; i++) {
-        printf("%10s | %12.1f | %10.1f | %16d |\n",
-               p[i].name, p[i].arrival_time, p[i].service_time, p[i].priority);
+    if (show_tables) report_printf(&report, "process_name | arrival_time | burst_time | process_priority |\n");
+    for(int i=0; show_tables && i<n; i++) {
+        report_printf(&report, "%10s | %12.1f | %10.1f | %16d |\n",
+                      p[i].name, p[i].arrival_time, p[i].service_time, p[i].priority);
     }
-    printf("total_number_of_processes: %d\n\n", n);
+    report_printf(&report, "total_number_of_processes: %d\n\n", n);
+}
+
+void print_table_header(void) {
+    report_printf(&report, "process_name | arrival_time | start_time | end_time | burst_time | response_time | wait_time | turn_around_time | priority |\n");
+    report_printf(&report, " -------------------------------------------------------------------------------------------------------------------------------- \n");
 }
 
-void print_detailed_table(Process p[], int n) {
-    printf("process_name | arrival_time | start_time | end_time | burst_time | response_time | wait_time | turn_around_time | priority |\n");
-    printf(" -------------------------------------------------------------------------------------------------------------------------------- \n");
+// Finished processes of the run held in t, whose inputs are p
+void print_detailed_table(const Process p[], const ProcTable *t) {
+    print_table_header();
    
-    for(int i=0; i<n; i++) {
-        if(p[i].finish_time > 0) {
-             printf("%13s| %13.1f| %12.1f| %10.1f| %10.1f| %14.1f| %10.1f| %17.1f| %9d|\n",
-                p[i].name, p[i].arrival_time, p[i].start_time, p[i].finish_time,
-                p[i].service_time, p[i].response_time, p[i].wait_time,
-                p[i].turnaround_time, p[i].priority);
+    for(int i=0; show_tables && i<t->num_processes; i++) {
+        ProcResult res = proc_table_result(t, i);
+        if(res.finish > 0) {
+            report_process_row(&report, &p[i], &res);
         }
     }
 }
 
-void print_hpf_by_priority(Process p[], int n) {
+// Tail rows under a results table, in the response / wait / turnaround columns
+void print_percentile_rows(const Metrics *m) {
+    report_printf(&report, "          p50|              |            |          |          | %14.1f| %10.1f| %17.1f|\n",
+                  m->response_pct.p50, m->wait_pct.p50, m->turnaround_pct.p50);
+    report_printf(&report, "          p95|              |            |          |          | %14.1f| %10.1f| %17.1f|\n",
+                  m->response_pct.p95, m->wait_pct.p95, m->turnaround_pct.p95);
+    report_printf(&report, "          p99|              |            |          |          | %14.1f| %10.1f| %17.1f|\n",
+                  m->response_pct.p99, m->wait_pct.p99, m->turnaround_pct.p99);
+    report_printf(&report, "          max|              |            |          |          | %14.1f| %10.1f| %17.1f|\n\n",
+                  m->response_pct.max, m->wait_pct.max, m->turnaround_pct.max);
+}
+
+void print_average_row(const Metrics *m) {
+    report_printf(&report, "      Average|           0.0|         0.0|       0.0|       0.0| %14.1f| %10.1f| %17.1f|\n",
+                  m->avg_response, m->avg_wait, m->avg_turnaround);
+}
+
+void print_hpf_by_priority(const Process p[], const ProcTable *t, const HPFMetrics *hm) {
     for (int prio = 1; prio <= 4; prio++) {
-        printf("For Priority Queue %d\n", prio);
-        printf("process_name | arrival_time | start_time | end_time | burst_time | response_time | wait_time | turn_around_time | priority |\n");
-        printf(" -------------------------------------------------------------------------------------------------------------------------------- \n");
+        const Metrics *m = &hm->priority[prio - 1];
+
+        report_printf(&report, "For Priority Queue %d\n", prio);
+        print_table_header();
        
-        int count = 0;
-        double total_tat=0, total_wt=0, total_rt=0;
-
-        for(int i=0; i<n; i++) {
-            if(p[i].priority == prio && p[i].finish_time > 0) {
-                 printf("%13s| %13.1f| %12.1f| %10.1f| %10.1f| %14.1f| %10.1f| %17.1f| %9d|\n",
-                    p[i].name, p[i].arrival_time, p[i].start_time, p[i].finish_time,
-                    p[i].service_time, p[i].response_time, p[i].wait_time,
-                    p[i].turnaround_time, p[i].priority);
-                 
-                 total_tat += p[i].turnaround_time;
-                 total_wt += p[i].wait_time;
-                 total_rt += p[i].response_time;
-                 count++;
+        for(int i=0; show_tables && i<t->num_processes; i++) {
+            if(p[i].priority != prio) continue;
+            ProcResult res = proc_table_result(t, i);
+            if(res.finish > 0) {
+                report_process_row(&report, &p[i], &res);
             }
         }
        
-        printf("      Average|           0.0|         0.0|       0.0|       0.0| %14.1f| %10.1f| %17.1f|\n\n",
-            (count > 0 ? total_rt/count : 0.0),
-            (count > 0 ? total_wt/count : 0.0),
-            (count > 0 ? total_tat/count : 0.0));
+        print_average_row(m);
+        print_percentile_rows(m);
+    }
+}
+
+// Results of one policy run: the per-process table(s), averages, tails and counters
+void print_policy_results(const PolicyInfo *policy, const Process p[], const ProcTable *t, const HPFMetrics *hm) {
+    const Metrics *m = &hm->overall;
+
+    if (policy->by_priority) {
+        print_hpf_by_priority(p, t, hm);
+
+        report_printf(&report, "Averages over all priority queues:\n");
+        report_printf(&report, "Average Turn Around Time(TAT) :%.1f\n", m->avg_turnaround);
+        report_printf(&report, "Average Wait Time(WT) : %.1f\n", m->avg_wait);
+        report_printf(&report, "Average Response Time(RT) : %.1f\n\n", m->avg_response);
+    } else {
+        print_detailed_table(p, t);
+        print_average_row(m);
+        print_percentile_rows(m);
+    }
+
+    print_core_stats(m);
+
+    if (policy->counter_names[0] != NULL) {
+        for (int i = 0; i < POLICY_COUNTERS && policy->counter_names[i] != NULL; i++) {
+            report_printf(&report, "%s%s: %.0f", (i > 0) ? "  " : "", policy->counter_names[i], m->counters[i]);
+        }
+        report_write(&report, "\n\n", 2);
+    }
+}
+
+// The same run as CSV rows or JSON lines: every finished process unless
+// --no-tables, then (JSON, or CSV with --no-tables) the summary per scope
+void record_policy_results(const PolicyInfo *policy, int run, const Process p[], const ProcTable *t,
+                           const HPFMetrics *hm) {
+    static const char *const priority_scopes[4] = {"priority1", "priority2", "priority3", "priority4"};
+
+    if (show_tables) {
+        for (int i = 0; i < t->num_processes; i++) {
+            ProcResult res = proc_table_result(t, i);
+            if (res.finish <= 0) continue;
+            if (report_format == FORMAT_CSV) {
+                report_csv_process(&report, run + 1, policy->name, &p[i], &res);
+            } else {
+                report_jsonl_process(&report, run + 1, policy->name, &p[i], &res);
+            }
+        }
+        if (report_format == FORMAT_CSV) return;
+    }
+
+    for (int scope = -1; scope < (policy->by_priority ? 4 : 0); scope++) {
+        const char *name = (scope < 0) ? "all" : priority_scopes[scope];
+        const Metrics *m = (scope < 0) ? &hm->overall : &hm->priority[scope];
+
+        if (report_format == FORMAT_CSV) {
+            report_csv_summary(&report, run + 1, policy->name, name, m);
+        } else {
+            report_jsonl_summary(&report, run + 1, policy->name, name, m);
+        }
     }
 }
 
 #define NUM_PROCESSES 40
 #define NUM_RUNS 5
-#define MAX_TIME 500
 
-int main() {
-    Process original_workload[NUM_PROCESSES];
-    Process temp_processes[NUM_PROCESSES];
-    char timeline[MAX_TIME][10];
-   
-    Metrics fcfs_final = {0}, sjf_final = {0}, srt_final = {0}, rr_final = {0};
-    HPFMetrics hpf_np_final = {0}, hpf_p_final = {0};
+void print_usage(const char *prog) {
+    printf("Usage: %s [--aging <quanta>] [--boost <quanta>] [--quantum <q>] [--context-switch <t>] [--cutoff <t>]\n"
+           "       [--processes <n>] [--trace <file>] [--save-trace <file>]\n"
+           "       [--cores <n> [--affinity]] [--policies <list>] [--timeline <file>]\n"
+           "       [--format text|csv|jsonl] [--no-tables] [--sweep <seeds> [--threads <n>]]\n", prog);
+    printf("  --aging <quanta>        HPF: promote a process one priority level after waiting this long\n");
+    printf("  --boost <quanta>        MLFQ: move every process back to the top level this often (default 50, 0 = never)\n");
+    printf("  --quantum <q>           RR: time slice length (default 1.0)\n");
+    printf("  --context-switch <t>    Overhead charged when the CPU switches process (default 0.0)\n");
+    printf("  --cutoff <t>            Start no process after time t (default 99, no cutoff with --trace)\n");
+    printf("  --processes <n>         Processes per generated workload (default %d)\n", NUM_PROCESSES);
+    printf("  --trace <file>          Run once on a CSV (arrival,burst,priority) or binary trace instead\n");
+    printf("  --save-trace <file>     Write the workload as a binary trace and exit\n");
+    printf("  --cores <n>             Simulate n CPUs with a ready queue each; idle CPUs steal work (default 1)\n");
+    printf("  --affinity              With --cores: keep process i on CPU i %% n and never steal\n");
+    printf("  --policies <list>       Comma-separated policies to run, in that order (default: all of\n"
+           "                          ");
+    for (int i = 0; i < num_registered_policies; i++) {
+        printf("%s%s", policy_registry[i].name, (i + 1 < num_registered_policies) ? "," : ")\n");
+    }
+    printf("  --timeline <file>       Write every run's CPU intervals (binary if the name ends in .bin)\n");
+    printf("  --format <fmt>          text (default), csv or jsonl results\n");
+    printf("  --no-tables             Leave out the per-process rows; print only averages, tails and totals\n");
+    printf("  --sweep <seeds>         Run all policies on this many seeds in parallel and print aggregates only\n");
+    printf("  --threads <n>           Sweep worker threads (default: number of online CPUs)\n");
+}
 
-    printf("Enter number of processes: %d\n", NUM_PROCESSES);
+int sweep_seeds = 0;   // 0 = normal run
+int sweep_threads = 0;  // 0 = one per online CPU
+int num_processes = NUM_PROCESSES;
+const char *trace_path = NULL;
+const char *save_trace_path = NULL;
+const char *timeline_path = NULL;
+int cutoff_set = 0;
+
+const PolicyInfo **selected_policies = NULL;
+int num_selected_policies = 0;
+
+// Parse a --policies list into selected_policies. Returns 0 on an unknown name.
+int select_policies(const char *list) {
+    char *copy = strdup(list);
+    selected_policies = (const PolicyInfo **)realloc(selected_policies, sizeof(PolicyInfo *) * (strlen(list) + 1));
+    num_selected_policies = 0;
+
+    for (char *name = strtok(copy, ","); name != NULL; name = strtok(NULL, ",")) {
+        const PolicyInfo *policy = find_policy(name);
+        if (policy == NULL) {
+            printf("Error: unknown policy %s\n", name);
+            free(copy);
+            return 0;
+        }
+        selected_policies[num_selected_policies++] = policy;
+    }
+
+    free(copy);
+    return num_selected_policies > 0;
+}
+
+Timeline timeline;
+TimelineWriter timeline_out;
+
+// Gantt chart of the last run (text output only), and its full interval log if --timeline was given
+void report_timeline(const char *policy, int run, const Process processes[]) {
+    if (report_format == FORMAT_TEXT) print_gantt_chart(&timeline, processes);
+    if (timeline_path != NULL) {
+        report_flush(&report);  // Keeps a write error after the output it belongs to
+        timeline_write(&timeline_out, policy, run + 1, &timeline, processes);
+    }
+}
+
+// Fill sched_config and the run mode from the command line. Returns 0 on a bad option.
+int parse_args(int argc, char *argv[]) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--aging") == 0 && i + 1 < argc) {
+            sched_config.aging_interval = atof(argv[++i]);
+            if (sched_config.aging_interval < 0.0) return 0;
+        } else if (strcmp(argv[i], "--boost") == 0 && i + 1 < argc) {
+            sched_config.mlfq_boost = atof(argv[++i]);
+            if (sched_config.mlfq_boost < 0.0) return 0;
+        } else if (strcmp(argv[i], "--quantum") == 0 && i + 1 < argc) {
+            sched_config.rr_quantum = atof(argv[++i]);
+            if (sched_config.rr_quantum <= 0.0) return 0;
+        } else if (strcmp(argv[i], "--context-switch") == 0 && i + 1 < argc) {
+            sched_config.context_switch = atof(argv[++i]);
+            if (sched_config.context_switch < 0.0) return 0;
+        } else if (strcmp(argv[i], "--cutoff") == 0 && i + 1 < argc) {
+            sched_config.start_cutoff = atof(argv[++i]);
+            cutoff_set = 1;
+        } else if (strcmp(argv[i], "--processes") == 0 && i + 1 < argc) {
+            num_processes = atoi(argv[++i]);
+            if (num_processes <= 0) return 0;
+        } else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            trace_path = argv[++i];
+        } else if (strcmp(argv[i], "--save-trace") == 0 && i + 1 < argc) {
+            save_trace_path = argv[++i];
+        } else if (strcmp(argv[i], "--cores") == 0 && i + 1 < argc) {
+            sched_config.num_cores = atoi(argv[++i]);
+            if (sched_config.num_cores <= 0) return 0;
+        } else if (strcmp(argv[i], "--affinity") == 0) {
+            sched_config.affinity = 1;
+        } else if (strcmp(argv[i], "--policies") == 0 && i + 1 < argc) {
+            if (!select_policies(argv[++i])) return 0;
+        } else if (strcmp(argv[i], "--timeline") == 0 && i + 1 < argc) {
+            timeline_path = argv[++i];
+        } else if (strcmp(argv[i], "--format") == 0 && i + 1 < argc) {
+            const char *format = argv[++i];
+            if (strcmp(format, "text") == 0) report_format = FORMAT_TEXT;
+            else if (strcmp(format, "csv") == 0) report_format = FORMAT_CSV;
+            else if (strcmp(format, "jsonl") == 0) report_format = FORMAT_JSONL;
+            else return 0;
+        } else if (strcmp(argv[i], "--no-tables") == 0) {
+            show_tables = 0;
+        } else if (strcmp(argv[i], "--sweep") == 0 && i + 1 < argc) {
+            sweep_seeds = atoi(argv[++i]);
+            if (sweep_seeds <= 0) return 0;
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            sweep_threads = atoi(argv[++i]);
+            if (sweep_threads <= 0) return 0;
+        } else {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int main(int argc, char *argv[]) {
+    if (!parse_args(argc, argv)) {
+        print_usage(argv[0]);
+        return 1;
+    }
 
     unsigned int seed = 42;
 
-    for (int run = 0; run < NUM_RUNS; run++) {
-        printf("\t\tIteration #%d\n", run + 1);
-       
-        generate_workload(original_workload, NUM_PROCESSES, seed + run);
-       
-        print_input_table(original_workload, NUM_PROCESSES);
-
-        printf("FIRST COME FIRST SERVE:\n");
-        reset_processes(original_workload, temp_processes, NUM_PROCESSES);
-        Metrics m_fcfs = fcfs(temp_processes, NUM_PROCESSES, timeline);
-        print_gantt_chart(temp_processes, NUM_PROCESSES);
-        print_detailed_table(temp_processes, NUM_PROCESSES);
-        printf("      Average|           0.0|         0.0|       0.0|       0.0| %10.1f| %10.1f| %16.1f|\n\n",
-               m_fcfs.avg_response, m_fcfs.avg_wait, m_fcfs.avg_turnaround);
-       
-        fcfs_final.avg_turnaround += m_fcfs.avg_turnaround;
-        fcfs_final.avg_wait += m_fcfs.avg_wait;
-        fcfs_final.avg_response += m_fcfs.avg_response;
-        fcfs_final.throughput += m_fcfs.throughput;
-
-        printf("ROUND ROBIN:\n");
-        reset_processes(original_workload, temp_processes, NUM_PROCESSES);
-        Metrics m_rr = round_robin(temp_processes, NUM_PROCESSES, timeline);
-        print_gantt_chart(temp_processes, NUM_PROCESSES);
-        print_detailed_table(temp_processes, NUM_PROCESSES);
-        printf("      Average|           0.0|         0.0|       0.0|       0.0| %10.1f| %10.1f| %16.1f|\n\n",
-               m_rr.avg_response, m_rr.avg_wait, m_rr.avg_turnaround);
-       
-        rr_final.avg_turnaround += m_rr.avg_turnaround;
-        rr_final.avg_wait += m_rr.avg_wait;
-        rr_final.avg_response += m_rr.avg_response;
-        rr_final.throughput += m_rr.throughput;
-
-        printf("SHORTEST JOB FIRST:\n");
-        reset_processes(original_workload, temp_processes, NUM_PROCESSES);
-        Metrics m_sjf = sjf(temp_processes, NUM_PROCESSES, timeline);
-        print_gantt_chart(temp_processes, NUM_PROCESSES);
-        print_detailed_table(temp_processes, NUM_PROCESSES);
-        printf("      Average|           0.0|         0.0|       0.0|       0.0| %10.1f| %10.1f| %16.1f|\n\n",
-               m_sjf.avg_response, m_sjf.avg_wait, m_sjf.avg_turnaround);
-       
-        sjf_final.avg_turnaround += m_sjf.avg_turnaround;
-        sjf_final.avg_wait += m_sjf.avg_wait;
-        sjf_final.avg_response += m_sjf.avg_response;
-        sjf_final.throughput += m_sjf.throughput;
-
-        printf("SHORTEST REMAINING TIME:\n");
-        reset_processes(original_workload, temp_processes, NUM_PROCESSES);
-        Metrics m_srt = srt(temp_processes, NUM_PROCESSES, timeline);
-        print_gantt_chart(temp_processes, NUM_PROCESSES);
-        print_detailed_table(temp_processes, NUM_PROCESSES);
-        printf("      Average|           0.0|         0.0|       0.0|       0.0| %10.1f| %10.1f| %16.1f|\n\n",
-               m_srt.avg_response, m_srt.avg_wait, m_srt.avg_turnaround);
-
-        srt_final.avg_turnaround += m_srt.avg_turnaround;
-        srt_final.avg_wait += m_srt.avg_wait;
-        srt_final.avg_response += m_srt.avg_response;
-        srt_final.throughput += m_srt.throughput;
-
-        printf("HIGHEST PRIORITY FIRST PREEMPTIVE:\n");
-        reset_processes(original_workload, temp_processes, NUM_PROCESSES);
-        HPFMetrics m_hpf_p = hpf_preemptive(temp_processes, NUM_PROCESSES, timeline);
-        print_gantt_chart(temp_processes, NUM_PROCESSES);
-        print_hpf_by_priority(temp_processes, NUM_PROCESSES);
-       
-        printf("The average times of High Priority First Preemptive for all queues:\n");
-        printf("Average Turn Around Time(TAT) :%.1f\n", m_hpf_p.overall.avg_turnaround);
-        printf("Average Wait Time(WT) : %.1f\n", m_hpf_p.overall.avg_wait);
-        printf("Average Response Time(RT) : %.1f\n\n", m_hpf_p.overall.avg_response);
-
-        hpf_p_final.overall.avg_turnaround += m_hpf_p.overall.avg_turnaround;
-        hpf_p_final.overall.avg_wait += m_hpf_p.overall.avg_wait;
-        hpf_p_final.overall.avg_response += m_hpf_p.overall.avg_response;
-        hpf_p_final.overall.throughput += m_hpf_p.overall.throughput;
-
-        printf("HIGHEST PRIORITY FIRST NON PREEMPTIVE:\n");
-        reset_processes(original_workload, temp_processes, NUM_PROCESSES);
-        HPFMetrics m_hpf_np = hpf_nonpreemptive(temp_processes, NUM_PROCESSES, timeline);
-        print_gantt_chart(temp_processes, NUM_PROCESSES);
-        print_hpf_by_priority(temp_processes, NUM_PROCESSES);
-
-        printf("The Calculated statistics of High Priority First Non Preemptive for all priority queues is:\n");
-        printf("Average Turn Around Time(TAT) :%.1f\n", m_hpf_np.overall.avg_turnaround);
-        printf("Average Wait Time(WT) : %.1f\n", m_hpf_np.overall.avg_wait);
-        printf("Average Response Time(RT) : %.1f\n", m_hpf_np.overall.avg_response);
-
-        hpf_np_final.overall.avg_turnaround += m_hpf_np.overall.avg_turnaround;
-        hpf_np_final.overall.avg_wait += m_hpf_np.overall.avg_wait;
-        hpf_np_final.overall.avg_response += m_hpf_np.overall.avg_response;
-        hpf_np_final.overall.throughput += m_hpf_np.overall.throughput;
-    }
-
-    printf("\nAll STATISTICS FOR %d ITERATIONS\n\n", NUM_RUNS);
+    if (selected_policies == NULL) {
+        selected_policies = (const PolicyInfo **)malloc(sizeof(PolicyInfo *) * num_registered_policies);
+        for (int i = 0; i < num_registered_policies; i++) selected_policies[i] = &policy_registry[i];
+        num_selected_policies = num_registered_policies;
+    }
+
+    if (sweep_seeds > 0) {
+        // A sweep generates its own workloads and prints only aggregates
+        if (trace_path != NULL || save_trace_path != NULL || timeline_path != NULL) {
+            printf("Error: --sweep cannot be combined with --trace, --save-trace or --timeline\n");
+            return 1;
+        }
+        if (report_format != FORMAT_TEXT) {
+            printf("Error: --sweep only prints text aggregates; --format csv and jsonl are not supported\n");
+            return 1;
+        }
+        if (sweep_threads == 0) {
+            long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+            sweep_threads = (cpus > 0) ? (int)cpus : 1;
+        }
+        run_sweep(selected_policies, num_selected_policies, sweep_seeds, sweep_threads, num_processes, seed);
+        return 0;
+    }
+
+    // A trace is one fixed workload, so it runs once; generated workloads run NUM_RUNS seeds
+    int num_runs = NUM_RUNS;
+    Process *original_workload;
+
+    if (trace_path != NULL) {
+        original_workload = load_trace(trace_path, &num_processes);
+        if (original_workload == NULL) return 1;
+        num_runs = 1;
+
+        // Trace jobs arrive over the whole trace, not just the first 100 quanta
+        if (!cutoff_set) sched_config.start_cutoff = HUGE_VAL;
+    } else {
+        original_workload = (Process *)malloc(sizeof(Process) * num_processes);
+    }
+
+    if (save_trace_path != NULL) {
+        if (trace_path == NULL) generate_workload(original_workload, num_processes, seed);
+        int ok = save_trace(save_trace_path, original_workload, num_processes);
+        free(original_workload);
+        return ok ? 0 : 1;
+    }
+
+    // original_workload is only read from here on; each policy's results live in the table
+    ProcTable table;
+    proc_table_init(&table, num_processes);
+    timeline_init(&timeline);
+    if (timeline_path != NULL && !timeline_writer_open(&timeline_out, timeline_path)) return 1;
    
-    printf("FIRST COME FIRST SERVE (FCFS):\n");
-    printf("Average Turn Around Time(TAT) :%.1f\n", fcfs_final.avg_turnaround / NUM_RUNS);
-    printf("Average Wait Time(WT) : %.1f\n", fcfs_final.avg_wait / NUM_RUNS);
-    printf("Average Response Time(RT) : %.1f\n", fcfs_final.avg_response / NUM_RUNS);
-    printf("Average Throughput :%.1f\n\n", fcfs_final.throughput / NUM_RUNS);
-
-    printf("SHORTEST JOB FIRST (SJF):\n");
-    printf("Average Turn Around Time(TAT) :%.1f\n", sjf_final.avg_turnaround / NUM_RUNS);
-    printf("Average Wait Time(WT) : %.1f\n", sjf_final.avg_wait / NUM_RUNS);
-    printf("Average Response Time(RT) : %.1f\n", sjf_final.avg_response / NUM_RUNS);
-    printf("Average Throughput :%.1f\n\n", sjf_final.throughput / NUM_RUNS);
-
-    printf("SHORTEST REMAINING TIME (SRT):\n");
-    printf("Average Turn Around Time(TAT) :%.1f\n", srt_final.avg_turnaround / NUM_RUNS);
-    printf("Average Wait Time(WT) : %.1f\n", srt_final.avg_wait / NUM_RUNS);
-    printf("Average Response Time(RT) : %.1f\n", srt_final.avg_response / NUM_RUNS);
-    printf("Average Throughput :%.1f\n\n", srt_final.throughput / NUM_RUNS);
-
-    printf("ROUND ROBIN (RR):\n");
-    printf("Average Turn Around Time(TAT) :%.1f\n", rr_final.avg_turnaround / NUM_RUNS);
-    printf("Average Wait Time(WT) : %.1f\n", rr_final.avg_wait / NUM_RUNS);
-    printf("Average Response Time(RT) : %.1f\n", rr_final.avg_response / NUM_RUNS);
-    printf("Average Throughput :%.1f\n\n", rr_final.throughput / NUM_RUNS);
-
-    printf("HIGHEST PRIORITY FIRST (HPF) [NON-PREEMPTIVE]:\n");
-    printf("Average Turn Around Time(TAT) :%.1f\n", hpf_np_final.overall.avg_turnaround / NUM_RUNS);
-    printf("Average Wait Time(WT) : %.1f\n", hpf_np_final.overall.avg_wait / NUM_RUNS);
-    printf("Average Response Time(RT) : %.1f\n", hpf_np_final.overall.avg_response / NUM_RUNS);
-    printf("Average Throughput :%.1f\n\n", hpf_np_final.overall.throughput / NUM_RUNS);
-
-    printf("HIGHEST PRIORITY FIRST (HPF) [PREEMPTIVE]:\n");
-    printf("Average Turn Around Time(TAT) :%.1f\n", hpf_p_final.overall.avg_turnaround / NUM_RUNS);
-    printf("Average Wait Time(WT) : %.1f\n", hpf_p_final.overall.avg_wait / NUM_RUNS);
-    printf("Average Response Time(RT) : %.1f\n", hpf_p_final.overall.avg_response / NUM_RUNS);
-    printf("Average Throughput :%.1f\n", hpf_p_final.overall.throughput / NUM_RUNS);
+    HPFMetrics *finals = (HPFMetrics *)calloc(num_selected_policies, sizeof(HPFMetrics));
+
+    // Results go through one large buffer rather than a printf per row
+    report_init(&report, stdout, 1 << 20);
+    if (report_format == FORMAT_TEXT) {
+        report_printf(&report, "Enter number of processes: %d\n", num_processes);
+    } else if (report_format == FORMAT_CSV) {
+        if (show_tables) report_csv_process_header(&report);
+        else report_csv_summary_header(&report);
+    }
+
+    for (int run = 0; run < num_runs; run++) {
+        if (trace_path == NULL) generate_workload(original_workload, num_processes, seed + run);
+        proc_table_load(&table, original_workload);
+
+        if (report_format == FORMAT_TEXT) {
+            report_printf(&report, "\t\tIteration #%d\n", run + 1);
+            print_input_table(original_workload, num_processes);
+        }
+
+        for (int i = 0; i < num_selected_policies; i++) {
+            const PolicyInfo *policy = selected_policies[i];
+
+            if (report_format == FORMAT_TEXT) report_printf(&report, "%s:\n", policy->title);
+            HPFMetrics m = sim_run(&table, policy->ops, &timeline);
+            report_timeline(policy->name, run, original_workload);
+            if (report_format == FORMAT_TEXT) {
+                print_policy_results(policy, original_workload, &table, &m);
+            } else {
+                record_policy_results(policy, run, original_workload, &table, &m);
+            }
+
+            finals[i].overall.avg_turnaround += m.overall.avg_turnaround;
+            finals[i].overall.avg_wait += m.overall.avg_wait;
+            finals[i].overall.avg_response += m.overall.avg_response;
+            finals[i].overall.throughput += m.overall.throughput;
+        }
+    }
+
+    // CSV rows are all per run; the text and JSON outputs end with the averages over runs
+    if (report_format == FORMAT_TEXT) {
+        report_printf(&report, "\nAll STATISTICS FOR %d ITERATIONS\n", num_runs);
+    }
+
+    for (int i = 0; report_format != FORMAT_CSV && i < num_selected_policies; i++) {
+        const Metrics *total = &finals[i].overall;
+
+        if (report_format == FORMAT_JSONL) {
+            report_jsonl_final(&report, selected_policies[i]->name, num_runs, total);
+            continue;
+        }
+        report_printf(&report, "\n%s (%s):\n", selected_policies[i]->title, selected_policies[i]->name);
+        report_printf(&report, "Average Turn Around Time(TAT) :%.1f\n", total->avg_turnaround / num_runs);
+        report_printf(&report, "Average Wait Time(WT) : %.1f\n", total->avg_wait / num_runs);
+        report_printf(&report, "Average Response Time(RT) : %.1f\n", total->avg_response / num_runs);
+        report_printf(&report, "Average Throughput :%.1f\n", total->throughput / num_runs);
+    }
 
+    report_free(&report);
+    free(finals);
+    timeline_free(&timeline);
+    if (timeline_path != NULL && !timeline_writer_close(&timeline_out)) return 1;
+    free(original_workload);
+    proc_table_free(&table);
     return 0;
 }
@@ -0,0 +1,139 @@
+#include <string.h>
+#include "metrics_simd.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HAVE_X86_SIMD 1
+#endif
+
+static void sum_scalar(const ProcTable *t, int begin, int end, double cutoff, MetricSums sums[4]) {
+    for (int i = begin; i < end; i++) {
+        if (t->completed[i] && t->start[i] <= cutoff) {
+            MetricSums *s = &sums[t->priority[i] - 1];
+            double turnaround = t->finish[i] - t->arrival[i];
+            s->turnaround += turnaround;
+            s->wait += turnaround - t->service[i];
+            s->response += t->start[i] - t->arrival[i];
+            s->count += 1.0;
+        }
+    }
+}
+
+#ifdef HAVE_X86_SIMD
+
+// 4 lanes per step. Returns how many processes it covered; the caller does the tail.
+__attribute__((target("avx2")))
+static int sum_avx2(const ProcTable *t, double cutoff, MetricSums sums[4]) {
+    int n = t->num_processes & ~3;
+    __m256d acc_t[4], acc_w[4], acc_r[4], acc_c[4];
+    for (int p = 0; p < 4; p++) {
+        acc_t[p] = acc_w[p] = acc_r[p] = acc_c[p] = _mm256_setzero_pd();
+    }
+    const __m256d vcutoff = _mm256_set1_pd(cutoff);
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d one = _mm256_set1_pd(1.0);
+
+    for (int i = 0; i < n; i += 4) {
+        __m256d arrival = _mm256_loadu_pd(t->arrival + i);
+        __m256d service = _mm256_loadu_pd(t->service + i);
+        __m256d start = _mm256_loadu_pd(t->start + i);
+        __m256d finish = _mm256_loadu_pd(t->finish + i);
+
+        int done_bytes;
+        memcpy(&done_bytes, t->completed + i, sizeof(int));
+        __m256d done = _mm256_cvtepi32_pd(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(done_bytes)));
+        __m256d prio = _mm256_cvtepi32_pd(_mm_loadu_si128((const __m128i *)(t->priority + i)));
+
+        __m256d live = _mm256_and_pd(_mm256_cmp_pd(done, zero, _CMP_NEQ_OQ),
+                                     _mm256_cmp_pd(start, vcutoff, _CMP_LE_OQ));
+        __m256d turnaround = _mm256_sub_pd(finish, arrival);
+        __m256d wait = _mm256_sub_pd(turnaround, service);
+        __m256d response = _mm256_sub_pd(start, arrival);
+
+        for (int p = 0; p < 4; p++) {
+            __m256d m = _mm256_and_pd(live, _mm256_cmp_pd(prio, _mm256_set1_pd(p + 1), _CMP_EQ_OQ));
+            acc_t[p] = _mm256_add_pd(acc_t[p], _mm256_and_pd(m, turnaround));
+            acc_w[p] = _mm256_add_pd(acc_w[p], _mm256_and_pd(m, wait));
+            acc_r[p] = _mm256_add_pd(acc_r[p], _mm256_and_pd(m, response));
+            acc_c[p] = _mm256_add_pd(acc_c[p], _mm256_and_pd(m, one));
+        }
+    }
+
+    for (int p = 0; p < 4; p++) {
+        double lanes[4];
+        _mm256_storeu_pd(lanes, acc_t[p]);
+        sums[p].turnaround += (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+        _mm256_storeu_pd(lanes, acc_w[p]);
+        sums[p].wait += (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+        _mm256_storeu_pd(lanes, acc_r[p]);
+        sums[p].response += (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+        _mm256_storeu_pd(lanes, acc_c[p]);
+        sums[p].count += (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    }
+    return n;
+}
+
+// Same as sum_avx2 with 2 lanes; SSE2 is part of every x86-64 CPU.
+static int sum_sse2(const ProcTable *t, double cutoff, MetricSums sums[4]) {
+    int n = t->num_processes & ~1;
+    __m128d acc_t[4], acc_w[4], acc_r[4], acc_c[4];
+    for (int p = 0; p < 4; p++) {
+        acc_t[p] = acc_w[p] = acc_r[p] = acc_c[p] = _mm_setzero_pd();
+    }
+    const __m128d vcutoff = _mm_set1_pd(cutoff);
+    const __m128d zero = _mm_setzero_pd();
+    const __m128d one = _mm_set1_pd(1.0);
+
+    for (int i = 0; i < n; i += 2) {
+        __m128d arrival = _mm_loadu_pd(t->arrival + i);
+        __m128d service = _mm_loadu_pd(t->service + i);
+        __m128d start = _mm_loadu_pd(t->start + i);
+        __m128d finish = _mm_loadu_pd(t->finish + i);
+
+        __m128d done = _mm_set_pd(t->completed[i + 1], t->completed[i]);
+        __m128d prio = _mm_cvtepi32_pd(_mm_loadl_epi64((const __m128i *)(t->priority + i)));
+
+        __m128d live = _mm_and_pd(_mm_cmpneq_pd(done, zero), _mm_cmple_pd(start, vcutoff));
+        __m128d turnaround = _mm_sub_pd(finish, arrival);
+        __m128d wait = _mm_sub_pd(turnaround, service);
+        __m128d response = _mm_sub_pd(start, arrival);
+
+        for (int p = 0; p < 4; p++) {
+            __m128d m = _mm_and_pd(live, _mm_cmpeq_pd(prio, _mm_set1_pd(p + 1)));
+            acc_t[p] = _mm_add_pd(acc_t[p], _mm_and_pd(m, turnaround));
+            acc_w[p] = _mm_add_pd(acc_w[p], _mm_and_pd(m, wait));
+            acc_r[p] = _mm_add_pd(acc_r[p], _mm_and_pd(m, response));
+            acc_c[p] = _mm_add_pd(acc_c[p], _mm_and_pd(m, one));
+        }
+    }
+
+    for (int p = 0; p < 4; p++) {
+        double lanes[2];
+        _mm_storeu_pd(lanes, acc_t[p]);
+        sums[p].turnaround += lanes[0] + lanes[1];
+        _mm_storeu_pd(lanes, acc_w[p]);
+        sums[p].wait += lanes[0] + lanes[1];
+        _mm_storeu_pd(lanes, acc_r[p]);
+        sums[p].response += lanes[0] + lanes[1];
+        _mm_storeu_pd(lanes, acc_c[p]);
+        sums[p].count += lanes[0] + lanes[1];
+    }
+    return n;
+}
+
+#endif
+
+void sum_metrics_by_priority(const ProcTable *t, double cutoff, MetricSums sums[4]) {
+    memset(sums, 0, sizeof(MetricSums) * 4);
+    int done = 0;
+
+#ifdef HAVE_X86_SIMD
+    if (__builtin_cpu_supports("avx2")) {
+        done = sum_avx2(t, cutoff, sums);
+    } else {
+        done = sum_sse2(t, cutoff, sums);
+    }
+#endif
+
+    sum_scalar(t, done, t->num_processes, cutoff, sums);
+}
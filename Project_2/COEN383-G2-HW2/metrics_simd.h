@@ -0,0 +1,19 @@
+#ifndef METRICS_SIMD_H
+#define METRICS_SIMD_H
+
+#include "proc_table.h"
+
+typedef struct {
+    double turnaround;
+    double wait;
+    double response;
+    double count;
+} MetricSums;
+
+// Sum turnaround, wait and response over the processes that completed and
+// started no later than cutoff, split by priority (sums[0] = priority 1).
+// Uses AVX2 when the CPU has it, SSE2 on other x86-64 machines and plain C
+// elsewhere; lanes for other processes are masked out rather than branched on.
+void sum_metrics_by_priority(const ProcTable *t, double cutoff, MetricSums sums[4]);
+
+#endif
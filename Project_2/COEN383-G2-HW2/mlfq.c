@@ -0,0 +1,114 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "process.h"
+#include "sim_engine.h"
+#include "policies.h"
+#include "ready_queue.h"
+
+// Multi-level feedback queue: every process enters at the top level, and
+// each time it uses up a whole slice it drops one level, where slices are
+// twice as long. Every sched_config.mlfq_boost quanta all processes go back
+// to the top so long jobs cannot starve.
+
+#define MLFQ_COUNTER_DEMOTIONS 0
+#define MLFQ_COUNTER_BOOSTS 1
+
+typedef struct {
+    Sim *sim;
+    PriorityRings ready;  // Level 0 = top, slice 1; level 3 = bottom, slice 8
+    int *level;           // Level pid last ran or queued at
+    int *epoch_of;        // Boost epoch in which level[pid] was set
+    int epoch;            // Boosts so far; an older epoch_of means pid has been boosted since
+    double next_boost;
+} MLFQState;
+
+static int mlfq_level(const MLFQState *s, int pid) {
+    return (s->epoch_of[pid] == s->epoch) ? s->level[pid] : 0;
+}
+
+static void mlfq_push(MLFQState *s, int level, int pid) {
+    s->level[pid] = level;
+    s->epoch_of[pid] = s->epoch;
+    priority_rings_push(&s->ready, level, pid, s->sim->current_time);
+}
+
+static void *mlfq_init(Sim *sim) {
+    MLFQState *s = (MLFQState *)malloc(sizeof(MLFQState));
+    s->sim = sim;
+    priority_rings_init(&s->ready, sim->num_processes);
+    s->level = (int *)malloc(sizeof(int) * (sim->num_processes > 0 ? sim->num_processes : 1));
+    s->epoch_of = (int *)malloc(sizeof(int) * (sim->num_processes > 0 ? sim->num_processes : 1));
+    s->epoch = 0;
+    s->next_boost = sched_config.mlfq_boost;
+    return s;
+}
+
+static void mlfq_destroy(void *state) {
+    MLFQState *s = (MLFQState *)state;
+    priority_rings_free(&s->ready);
+    free(s->level);
+    free(s->epoch_of);
+    free(s);
+}
+
+static void mlfq_on_arrival(void *state, int pid) {
+    mlfq_push((MLFQState *)state, 0, pid);
+}
+
+// Splice the lower levels onto the top one in level order, which keeps each
+// level's FIFO order; queued and running processes pick up the new epoch lazily
+static void mlfq_boost(MLFQState *s) {
+    for (int level = 1; level < NUM_PRIORITIES; level++) {
+        priority_rings_splice(&s->ready, level, 0);
+    }
+    s->epoch++;
+    s->sim->counters[MLFQ_COUNTER_BOOSTS]++;
+}
+
+static int mlfq_pick_next(void *state) {
+    MLFQState *s = (MLFQState *)state;
+    double now = s->sim->current_time;
+
+    if (sched_config.mlfq_boost > 0.0 && now >= s->next_boost) {
+        mlfq_boost(s);
+        while (s->next_boost <= now) s->next_boost += sched_config.mlfq_boost;
+    }
+
+    while (!priority_rings_empty(&s->ready)) {
+        int pid = priority_rings_pop(&s->ready, priority_rings_top(&s->ready));
+
+        // Don't start new process after the cutoff (quantum 99 by default), like RR
+        if (sim_too_late(s->sim, pid)) continue;
+
+        return pid;
+    }
+
+    return SIM_IDLE;
+}
+
+static void mlfq_on_preempt(void *state, int pid) {
+    MLFQState *s = (MLFQState *)state;
+
+    // It used its whole slice: one level down, unless already at the bottom
+    int level = mlfq_level(s, pid);
+    if (level < NUM_PRIORITIES - 1) {
+        level++;
+        s->sim->counters[MLFQ_COUNTER_DEMOTIONS]++;
+    }
+    mlfq_push(s, level, pid);
+}
+
+static double mlfq_quantum_of(void *state, int pid) {
+    return (double)(1 << mlfq_level((MLFQState *)state, pid));
+}
+
+const SchedOps mlfq_ops = {
+    .quantum = 1.0,
+    .init = mlfq_init,
+    .destroy = mlfq_destroy,
+    .on_arrival = mlfq_on_arrival,
+    .pick_next = mlfq_pick_next,
+    .on_preempt = mlfq_on_preempt,
+    .quantum_of = mlfq_quantum_of,
+};
@@ -0,0 +1,23 @@
+#include <stdio.h>
+#include <strings.h>
+#include "policies.h"
+
+const PolicyInfo policy_registry[] = {
+    {"FCFS", "FIRST COME FIRST SERVE", &fcfs_ops, 0, {NULL, NULL}},
+    {"SJF", "SHORTEST JOB FIRST", &sjf_ops, 0, {NULL, NULL}},
+    {"SRT", "SHORTEST REMAINING TIME", &srt_ops, 0, {NULL, NULL}},
+    {"RR", "ROUND ROBIN", &rr_ops, 0, {NULL, NULL}},
+    {"HPF-NP", "HIGHEST PRIORITY FIRST NON PREEMPTIVE", &hpf_np_ops, 1, {NULL, NULL}},
+    {"HPF-P", "HIGHEST PRIORITY FIRST PREEMPTIVE", &hpf_p_ops, 1, {NULL, NULL}},
+    {"MLFQ", "MULTI-LEVEL FEEDBACK QUEUE", &mlfq_ops, 0, {"Demotions", "Boosts"}},
+    {"CFS", "COMPLETELY FAIR SCHEDULER", &cfs_ops, 0, {"Slices", "Preemptions"}},
+};
+
+const int num_registered_policies = (int)(sizeof(policy_registry) / sizeof(policy_registry[0]));
+
+const PolicyInfo *find_policy(const char *name) {
+    for (int i = 0; i < num_registered_policies; i++) {
+        if (strcasecmp(policy_registry[i].name, name) == 0) return &policy_registry[i];
+    }
+    return NULL;
+}
@@ -0,0 +1,32 @@
+#ifndef POLICIES_H
+#define POLICIES_H
+
+#include "sim_engine.h"
+
+// Every scheduling policy the simulator knows. The driver, sweep mode and any
+// other front end iterate this table, so adding a policy means writing its
+// SchedOps and adding one entry to policy_registry in policies.c.
+typedef struct {
+    const char *name;               // Short name: --policies, sweep rows, timeline blocks
+    const char *title;              // Heading of its results
+    const SchedOps *ops;
+    int by_priority;                // Report results per priority queue (HPF)
+    const char *counter_names[POLICY_COUNTERS];  // Labels for Metrics.counters, NULL = unused
+} PolicyInfo;
+
+extern const SchedOps fcfs_ops;
+extern const SchedOps sjf_ops;
+extern const SchedOps srt_ops;
+extern const SchedOps rr_ops;
+extern const SchedOps hpf_np_ops;
+extern const SchedOps hpf_p_ops;
+extern const SchedOps mlfq_ops;
+extern const SchedOps cfs_ops;
+
+extern const PolicyInfo policy_registry[];
+extern const int num_registered_policies;
+
+// Case-insensitive lookup by name, NULL if unknown
+const PolicyInfo *find_policy(const char *name);
+
+#endif
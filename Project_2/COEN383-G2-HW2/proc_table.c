@@ -0,0 +1,93 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "proc_table.h"
+#include "metrics_simd.h"
+
+void proc_table_init(ProcTable *t, int num_processes) {
+    int n = (num_processes > 0) ? num_processes : 1;
+
+    t->num_processes = num_processes;
+    t->arrival = (double *)malloc(sizeof(double) * n);
+    t->service = (double *)malloc(sizeof(double) * n);
+    t->priority = (int *)malloc(sizeof(int) * n);
+    t->remaining = (double *)malloc(sizeof(double) * n);
+    t->start = (double *)malloc(sizeof(double) * n);
+    t->finish = (double *)malloc(sizeof(double) * n);
+    t->completed = (unsigned char *)malloc(n);
+}
+
+void proc_table_free(ProcTable *t) {
+    free(t->arrival);
+    free(t->service);
+    free(t->priority);
+    free(t->remaining);
+    free(t->start);
+    free(t->finish);
+    free(t->completed);
+    memset(t, 0, sizeof(ProcTable));
+}
+
+void proc_table_load(ProcTable *t, const Process processes[]) {
+    for (int i = 0; i < t->num_processes; i++) {
+        t->arrival[i] = processes[i].arrival_time;
+        t->service[i] = processes[i].service_time;
+        t->priority[i] = processes[i].priority;
+    }
+    proc_table_reset(t);
+}
+
+void proc_table_reset(ProcTable *t) {
+    int n = t->num_processes;
+
+    memcpy(t->remaining, t->service, sizeof(double) * n);
+    for (int i = 0; i < n; i++) {
+        t->start[i] = -1.0;
+        t->finish[i] = 0.0;
+    }
+    memset(t->completed, 0, n);
+}
+
+ProcResult proc_table_result(const ProcTable *t, int pid) {
+    ProcResult r = {t->start[pid], 0.0, 0.0, 0.0, 0.0};
+
+    if (t->start[pid] >= 0.0) r.response = t->start[pid] - t->arrival[pid];
+    if (t->completed[pid]) {
+        r.finish = t->finish[pid];
+        r.turnaround = r.finish - t->arrival[pid];
+        r.wait = r.turnaround - t->service[pid];
+    }
+    return r;
+}
+
+HPFMetrics proc_table_metrics(const ProcTable *t) {
+    HPFMetrics hm;
+    memset(&hm, 0, sizeof(HPFMetrics));
+
+    MetricSums sums[4];
+    sum_metrics_by_priority(t, sched_config.start_cutoff, sums);
+
+    double total_completed = 0.0;
+    for (int p = 0; p < 4; p++) {
+        if (sums[p].count > 0) {
+            hm.priority[p].avg_turnaround = sums[p].turnaround / sums[p].count;
+            hm.priority[p].avg_wait = sums[p].wait / sums[p].count;
+            hm.priority[p].avg_response = sums[p].response / sums[p].count;
+        }
+        hm.priority[p].throughput = sums[p].count;
+
+        hm.overall.avg_turnaround += sums[p].turnaround;
+        hm.overall.avg_wait += sums[p].wait;
+        hm.overall.avg_response += sums[p].response;
+        total_completed += sums[p].count;
+    }
+
+    if (total_completed > 0) {
+        hm.overall.avg_turnaround /= total_completed;
+        hm.overall.avg_wait /= total_completed;
+        hm.overall.avg_response /= total_completed;
+    }
+    hm.overall.throughput = total_completed;
+
+    return hm;
+}
@@ -0,0 +1,55 @@
+#ifndef PROC_TABLE_H
+#define PROC_TABLE_H
+
+#include "process.h"
+
+// Structure-of-arrays view of a workload for the scheduler hot loops. Each
+// field is its own contiguous array indexed by pid (position in the
+// arrival-sorted Process array), so the engine, the ready queues and the
+// metrics reduction only pull in the columns they use instead of striding
+// over whole Process records.
+//
+// The input columns are loaded once per workload and only read during a run;
+// every policy run starts by resetting the small run columns, so comparing
+// several policies on one workload copies no Process records at all.
+typedef struct {
+    int num_processes;
+
+    // Input columns, fixed for the workload
+    double *arrival;
+    double *service;
+    int *priority;
+
+    // Run columns, written by the engine
+    double *remaining;
+    double *start;               // -1 until first dispatched
+    double *finish;
+    unsigned char *completed;
+} ProcTable;
+
+// Times of one process after a run. Fields for parts that did not happen are
+// 0, except start, which stays -1 if the process never ran.
+typedef struct {
+    double start;
+    double finish;
+    double response;
+    double wait;
+    double turnaround;
+} ProcResult;
+
+// Allocate a table for num_processes processes; proc_table_load fills it
+void proc_table_init(ProcTable *t, int num_processes);
+void proc_table_free(ProcTable *t);
+
+// Take the inputs of a new workload (sorted by arrival, t->num_processes long)
+void proc_table_load(ProcTable *t, const Process processes[]);
+
+// Fresh run columns over the same inputs, for the next policy
+void proc_table_reset(ProcTable *t);
+
+ProcResult proc_table_result(const ProcTable *t, int pid);
+
+// Overall and per-priority averages over completed processes started by the cutoff
+HPFMetrics proc_table_metrics(const ProcTable *t);
+
+#endif
@@ -1,27 +1,38 @@
 #ifndef PROCESS_H
 #define PROCESS_H
 
+// One job of a workload, as generated or read from a trace. Input only: what
+// happens to it in a run is kept in the ProcTable run columns.
 typedef struct {
     int id;
-    char name[3];
+    char name[12];  // A-Z, a-z, then the numeric id
     double arrival_time;
     double service_time;
-    double remaining_time;
     int priority;
-    double start_time;
-    double finish_time;
-    double turnaround_time;
-    double wait_time;
-    double response_time;
-    int completed;
-    int first_run;
 } Process;
 
+typedef struct {
+    double p50;
+    double p95;
+    double p99;
+    double max;
+} Percentiles;
+
+#define POLICY_COUNTERS 2
+
 typedef struct {
     double avg_turnaround;
     double avg_wait;
     double avg_response;
     double throughput;
+    Percentiles turnaround_pct;
+    Percentiles wait_pct;
+    Percentiles response_pct;
+    double context_switches;  // Run-wide counters, set on the overall metrics only
+    double steals;
+    double utilization;       // Busy CPU time / (cores * run length)
+    double events;            // Arrivals, slice ends and completions the engine handled
+    double counters[POLICY_COUNTERS];  // Policy-specific, e.g. MLFQ demotions and boosts
 } Metrics;
 
 typedef struct {
@@ -29,12 +40,22 @@ typedef struct {
     Metrics priority[4];  // Metrics for each priority level (0-3 for priorities 1-4)
 } HPFMetrics;
 
+// Runtime options, set from the command line in main()
+typedef struct {
+    double aging_interval;  // HPF: promote a process one level after waiting this long (0 = off)
+    double rr_quantum;      // RR: time slice length
+    double context_switch;  // Overhead charged each time the CPU switches to a different process
+    double start_cutoff;    // No process is started after this time (quantum 99 by default)
+    int num_cores;          // CPUs simulated, each with its own ready queue
+    int affinity;           // Pin each process to core pid % num_cores and never steal
+    double mlfq_boost;      // MLFQ: move every process back to the top level this often (0 = never)
+} SchedConfig;
+
+extern SchedConfig sched_config;
+
 // Function prototypes
+void init_process(Process *p, int index, double arrival_time, double service_time, int priority);
+void sort_by_arrival(Process processes[], int num_processes);
 void generate_workload(Process processes[], int num_processes, unsigned int seed);
-void print_processes(Process processes[], int num_processes);
-void print_timeline(int timeline[], int length);
-Metrics calculate_metrics(Process processes[], int num_processes);
-HPFMetrics calculate_hpf_metrics(Process processes[], int num_processes);
-void reset_processes(Process original[], Process copy[], int num_processes);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,151 @@
+#include <stdlib.h>
+#include "ready_queue.h"
+
+static int entry_before(const HeapEntry *a, const HeapEntry *b) {
+    if (a->key != b->key) return a->key < b->key;
+    return a->pid < b->pid;
+}
+
+void ready_heap_init(ReadyHeap *h, int capacity) {
+    if (capacity < 1) capacity = 1;
+    h->entries = (HeapEntry *)malloc(sizeof(HeapEntry) * capacity);
+    h->size = 0;
+    h->capacity = capacity;
+}
+
+void ready_heap_free(ReadyHeap *h) {
+    free(h->entries);
+    h->entries = NULL;
+    h->size = 0;
+    h->capacity = 0;
+}
+
+void ready_heap_push(ReadyHeap *h, double key, int pid) {
+    if (h->size == h->capacity) {
+        h->capacity *= 2;
+        h->entries = (HeapEntry *)realloc(h->entries, sizeof(HeapEntry) * h->capacity);
+    }
+
+    HeapEntry e = {key, pid};
+
+    // Sift up
+    int i = h->size++;
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (!entry_before(&e, &h->entries[parent])) break;
+        h->entries[i] = h->entries[parent];
+        i = parent;
+    }
+    h->entries[i] = e;
+}
+
+int ready_heap_pop(ReadyHeap *h) {
+    int top = h->entries[0].pid;
+    HeapEntry last = h->entries[--h->size];
+
+    // Sift down
+    int i = 0;
+    while (1) {
+        int child = 2 * i + 1;
+        if (child >= h->size) break;
+        if (child + 1 < h->size && entry_before(&h->entries[child + 1], &h->entries[child])) {
+            child++;
+        }
+        if (!entry_before(&h->entries[child], &last)) break;
+        h->entries[i] = h->entries[child];
+        i = child;
+    }
+    if (h->size > 0) h->entries[i] = last;
+
+    return top;
+}
+
+void fifo_ring_init(FifoRing *q, int capacity) {
+    if (capacity < 1) capacity = 1;
+    q->items = (int *)malloc(sizeof(int) * capacity);
+    q->head = 0;
+    q->count = 0;
+    q->capacity = capacity;
+}
+
+void fifo_ring_free(FifoRing *q) {
+    free(q->items);
+    q->items = NULL;
+    q->count = 0;
+}
+
+void priority_rings_init(PriorityRings *r, int num_processes) {
+    if (num_processes < 1) num_processes = 1;
+    r->next = (int *)malloc(sizeof(int) * num_processes);
+    r->enqueued_at = (double *)malloc(sizeof(double) * num_processes);
+    r->level = (int *)malloc(sizeof(int) * num_processes);
+    for (int p = 0; p < NUM_PRIORITIES; p++) r->tail[p] = -1;
+    r->occupied = 0;
+}
+
+void priority_rings_free(PriorityRings *r) {
+    free(r->next);
+    free(r->enqueued_at);
+    free(r->level);
+    r->next = NULL;
+    r->enqueued_at = NULL;
+    r->level = NULL;
+}
+
+void priority_rings_push(PriorityRings *r, int level, int pid, double now) {
+    int tail = r->tail[level];
+    if (tail == -1) {
+        r->next[pid] = pid;
+        r->occupied |= 1u << level;
+    } else {
+        r->next[pid] = r->next[tail];
+        r->next[tail] = pid;
+    }
+    r->tail[level] = pid;
+    r->enqueued_at[pid] = now;
+    r->level[pid] = level;
+}
+
+int priority_rings_pop(PriorityRings *r, int level) {
+    int tail = r->tail[level];
+    int head = r->next[tail];
+    if (head == tail) {
+        r->tail[level] = -1;
+        r->occupied &= ~(1u << level);
+    } else {
+        r->next[tail] = r->next[head];
+    }
+    return head;
+}
+
+// Promote every process that has waited at least interval at its level by one
+// level. Each ring is in enqueue order, so only the heads need checking.
+void priority_rings_age(PriorityRings *r, double now, double interval) {
+    for (int level = 1; level < NUM_PRIORITIES; level++) {
+        while (r->tail[level] != -1) {
+            int head = priority_rings_head(r, level);
+            if (now - r->enqueued_at[head] < interval) break;
+            priority_rings_pop(r, level);
+            priority_rings_push(r, level - 1, head, now);
+        }
+    }
+}
+
+// Move the whole of ring `from` behind ring `to` in O(1). level[] and
+// enqueued_at[] of the moved processes are left as they were.
+void priority_rings_splice(PriorityRings *r, int from, int to) {
+    int from_tail = r->tail[from];
+    if (from_tail == -1 || from == to) return;
+
+    int to_tail = r->tail[to];
+    if (to_tail != -1) {
+        int from_head = r->next[from_tail];
+        r->next[from_tail] = r->next[to_tail];
+        r->next[to_tail] = from_head;
+    }
+    r->tail[to] = from_tail;
+    r->occupied |= 1u << to;
+
+    r->tail[from] = -1;
+    r->occupied &= ~(1u << from);
+}
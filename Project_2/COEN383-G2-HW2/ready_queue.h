@@ -0,0 +1,99 @@
+#ifndef READY_QUEUE_H
+#define READY_QUEUE_H
+
+// Ready queues the policies keep their arrived, unfinished processes in.
+// Entries are indices into the process array.
+
+typedef struct {
+    double key;
+    int pid;
+} HeapEntry;
+
+// Binary min-heap ordered by key, ties broken by lowest pid (= earliest arrival)
+typedef struct {
+    HeapEntry *entries;
+    int size;
+    int capacity;
+} ReadyHeap;
+
+void ready_heap_init(ReadyHeap *h, int capacity);
+void ready_heap_free(ReadyHeap *h);
+void ready_heap_push(ReadyHeap *h, double key, int pid);
+int ready_heap_pop(ReadyHeap *h);
+
+static inline int ready_heap_empty(const ReadyHeap *h) {
+    return h->size == 0;
+}
+
+static inline int ready_heap_peek(const ReadyHeap *h) {
+    return h->entries[0].pid;
+}
+
+// Fixed-capacity FIFO ring buffer. A process is queued at most once at a
+// time, so a capacity of num_processes never overflows.
+typedef struct {
+    int *items;
+    int head;
+    int count;
+    int capacity;
+} FifoRing;
+
+void fifo_ring_init(FifoRing *q, int capacity);
+void fifo_ring_free(FifoRing *q);
+
+static inline int fifo_ring_empty(const FifoRing *q) {
+    return q->count == 0;
+}
+
+static inline int fifo_ring_peek(const FifoRing *q) {
+    return q->items[q->head];
+}
+
+static inline void fifo_ring_push(FifoRing *q, int pid) {
+    int tail = q->head + q->count;
+    if (tail >= q->capacity) tail -= q->capacity;
+    q->items[tail] = pid;
+    q->count++;
+}
+
+static inline int fifo_ring_pop(FifoRing *q) {
+    int pid = q->items[q->head];
+    if (++q->head == q->capacity) q->head = 0;
+    q->count--;
+    return pid;
+}
+
+#define NUM_PRIORITIES 4
+
+// One FIFO ring per priority level (level 0 = priority 1 = highest). The rings
+// are intrusive: links live in a per-process next[] array, so a process can sit
+// in at most one level and push/pop/rotate are O(1) with no per-node allocation.
+typedef struct {
+    int *next;                    // next[pid] = following pid in pid's ring
+    double *enqueued_at;          // When pid joined its current level (for aging)
+    int *level;                   // Level pid is currently queued at
+    int tail[NUM_PRIORITIES];     // Last pid of each ring, -1 when empty
+    unsigned int occupied;        // Bit p set while level p is non-empty
+} PriorityRings;
+
+void priority_rings_init(PriorityRings *r, int num_processes);
+void priority_rings_free(PriorityRings *r);
+void priority_rings_push(PriorityRings *r, int level, int pid, double now);
+int priority_rings_pop(PriorityRings *r, int level);
+void priority_rings_age(PriorityRings *r, double now, double interval);
+void priority_rings_splice(PriorityRings *r, int from, int to);
+
+static inline int priority_rings_empty(const PriorityRings *r) {
+    return r->occupied == 0;
+}
+
+// Highest non-empty level
+static inline int priority_rings_top(const PriorityRings *r) {
+    return __builtin_ctz(r->occupied);
+}
+
+static inline int priority_rings_head(const PriorityRings *r, int level) {
+    return r->next[r->tail[level]];
+}
+
+#endif
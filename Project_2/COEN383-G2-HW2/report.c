@@ -0,0 +1,210 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <math.h>
+#include "report.h"
+
+// Room a single formatted line is expected to fit in
+#define REPORT_LINE_MAX 1024
+
+void report_init(Report *r, FILE *out, size_t capacity) {
+    if (capacity < 2 * REPORT_LINE_MAX) capacity = 2 * REPORT_LINE_MAX;
+    r->out = out;
+    r->buf = (char *)malloc(capacity);
+    r->len = 0;
+    r->capacity = capacity;
+}
+
+void report_free(Report *r) {
+    report_flush(r);
+    free(r->buf);
+    r->buf = NULL;
+    r->capacity = 0;
+}
+
+void report_flush(Report *r) {
+    if (r->len > 0) {
+        fwrite(r->buf, 1, r->len, r->out);
+        r->len = 0;
+    }
+}
+
+static void reserve(Report *r, size_t n) {
+    if (r->capacity - r->len < n) report_flush(r);
+}
+
+void report_write(Report *r, const char *s, size_t n) {
+    if (n > r->capacity / 2) {
+        report_flush(r);
+        fwrite(s, 1, n, r->out);
+        return;
+    }
+    reserve(r, n);
+    memcpy(r->buf + r->len, s, n);
+    r->len += n;
+}
+
+void report_printf(Report *r, const char *fmt, ...) {
+    reserve(r, REPORT_LINE_MAX);
+
+    va_list args;
+    va_start(args, fmt);
+    int n = vsnprintf(r->buf + r->len, r->capacity - r->len, fmt, args);
+    va_end(args);
+    if (n < 0) return;
+
+    if ((size_t)n < r->capacity - r->len) {
+        r->len += n;
+        return;
+    }
+
+    // Longer than the whole free space: format it on its own
+    char *big = (char *)malloc(n + 1);
+    va_start(args, fmt);
+    vsnprintf(big, n + 1, fmt, args);
+    va_end(args);
+    report_write(r, big, n);
+    free(big);
+}
+
+void report_fixed1(Report *r, double value, int width) {
+    double magnitude = fabs(value);
+
+    // Round |value| * 10 to an integer ourselves unless it sits so close to a
+    // tie (or is so large) that only printf's exact decimal rounding is safe
+    if (magnitude < 1e9) {
+        double scaled = magnitude * 10.0;
+        double whole = floor(scaled);
+        double frac = scaled - whole;
+
+        if (fabs(frac - 0.5) > 1e-6) {
+            long long q = (long long)whole + (frac > 0.5);
+            char digits[32];
+            int len = 0;
+
+            digits[len++] = (char)('0' + q % 10);
+            digits[len++] = '.';
+            q /= 10;
+            do {
+                digits[len++] = (char)('0' + q % 10);
+                q /= 10;
+            } while (q > 0);
+            if (signbit(value)) digits[len++] = '-';
+
+            reserve(r, (size_t)(width > len ? width : len));
+            for (int i = len; i < width; i++) r->buf[r->len++] = ' ';
+            while (len > 0) r->buf[r->len++] = digits[--len];
+            return;
+        }
+    }
+
+    report_printf(r, "%*.1f", width, value);
+}
+
+static void report_int(Report *r, int value, int width) {
+    char digits[16];
+    int len = 0;
+    unsigned int u = (value < 0) ? -(unsigned int)value : (unsigned int)value;
+
+    do {
+        digits[len++] = (char)('0' + u % 10);
+        u /= 10;
+    } while (u > 0);
+    if (value < 0) digits[len++] = '-';
+
+    reserve(r, (size_t)(width > len ? width : len));
+    for (int i = len; i < width; i++) r->buf[r->len++] = ' ';
+    while (len > 0) r->buf[r->len++] = digits[--len];
+}
+
+static void report_padded(Report *r, const char *s, int width) {
+    int len = (int)strlen(s);
+    reserve(r, (size_t)(width > len ? width : len));
+    for (int i = len; i < width; i++) r->buf[r->len++] = ' ';
+    memcpy(r->buf + r->len, s, len);
+    r->len += len;
+}
+
+// "%13s| %13.1f| %12.1f| %10.1f| %10.1f| %14.1f| %10.1f| %17.1f| %9d|\n"
+void report_process_row(Report *r, const Process *p, const ProcResult *res) {
+    report_padded(r, p->name, 13);
+    report_write(r, "| ", 2);
+    report_fixed1(r, p->arrival_time, 13);
+    report_write(r, "| ", 2);
+    report_fixed1(r, res->start, 12);
+    report_write(r, "| ", 2);
+    report_fixed1(r, res->finish, 10);
+    report_write(r, "| ", 2);
+    report_fixed1(r, p->service_time, 10);
+    report_write(r, "| ", 2);
+    report_fixed1(r, res->response, 14);
+    report_write(r, "| ", 2);
+    report_fixed1(r, res->wait, 10);
+    report_write(r, "| ", 2);
+    report_fixed1(r, res->turnaround, 17);
+    report_write(r, "| ", 2);
+    report_int(r, p->priority, 9);
+    report_write(r, "|\n", 2);
+}
+
+void report_csv_process_header(Report *r) {
+    report_printf(r, "run,policy,name,id,priority,arrival,burst,start,finish,response,wait,turnaround\n");
+}
+
+void report_csv_process(Report *r, int run, const char *policy, const Process *p, const ProcResult *res) {
+    report_printf(r, "%d,%s,%s,%d,%d,%.10g,%.10g,%.10g,%.10g,%.10g,%.10g,%.10g\n",
+                  run, policy, p->name, p->id, p->priority, p->arrival_time, p->service_time,
+                  res->start, res->finish, res->response, res->wait, res->turnaround);
+}
+
+void report_csv_summary_header(Report *r) {
+    report_printf(r, "run,policy,scope,completed,avg_turnaround,avg_wait,avg_response,"
+                     "p50_turnaround,p95_turnaround,p99_turnaround,max_turnaround,"
+                     "p50_wait,p95_wait,p99_wait,max_wait,"
+                     "p50_response,p95_response,p99_response,max_response\n");
+}
+
+static void csv_percentiles(Report *r, const Percentiles *p) {
+    report_printf(r, ",%.10g,%.10g,%.10g,%.10g", p->p50, p->p95, p->p99, p->max);
+}
+
+void report_csv_summary(Report *r, int run, const char *policy, const char *scope, const Metrics *m) {
+    report_printf(r, "%d,%s,%s,%.0f,%.10g,%.10g,%.10g", run, policy, scope, m->throughput,
+                  m->avg_turnaround, m->avg_wait, m->avg_response);
+    csv_percentiles(r, &m->turnaround_pct);
+    csv_percentiles(r, &m->wait_pct);
+    csv_percentiles(r, &m->response_pct);
+    report_write(r, "\n", 1);
+}
+
+void report_jsonl_process(Report *r, int run, const char *policy, const Process *p, const ProcResult *res) {
+    report_printf(r, "{\"type\":\"process\",\"run\":%d,\"policy\":\"%s\",\"name\":\"%s\",\"id\":%d,"
+                     "\"priority\":%d,\"arrival\":%.10g,\"burst\":%.10g,\"start\":%.10g,\"finish\":%.10g,"
+                     "\"response\":%.10g,\"wait\":%.10g,\"turnaround\":%.10g}\n",
+                  run, policy, p->name, p->id, p->priority, p->arrival_time, p->service_time,
+                  res->start, res->finish, res->response, res->wait, res->turnaround);
+}
+
+static void jsonl_percentiles(Report *r, const char *key, const Percentiles *p) {
+    report_printf(r, ",\"%s\":{\"p50\":%.10g,\"p95\":%.10g,\"p99\":%.10g,\"max\":%.10g}",
+                  key, p->p50, p->p95, p->p99, p->max);
+}
+
+void report_jsonl_summary(Report *r, int run, const char *policy, const char *scope, const Metrics *m) {
+    report_printf(r, "{\"type\":\"summary\",\"run\":%d,\"policy\":\"%s\",\"scope\":\"%s\",\"completed\":%.0f,"
+                     "\"avg_turnaround\":%.10g,\"avg_wait\":%.10g,\"avg_response\":%.10g",
+                  run, policy, scope, m->throughput, m->avg_turnaround, m->avg_wait, m->avg_response);
+    jsonl_percentiles(r, "turnaround", &m->turnaround_pct);
+    jsonl_percentiles(r, "wait", &m->wait_pct);
+    jsonl_percentiles(r, "response", &m->response_pct);
+    report_write(r, "}\n", 2);
+}
+
+// totals holds the overall metrics summed over num_runs runs
+void report_jsonl_final(Report *r, const char *policy, int num_runs, const Metrics *totals) {
+    report_printf(r, "{\"type\":\"final\",\"policy\":\"%s\",\"runs\":%d,\"avg_turnaround\":%.10g,"
+                     "\"avg_wait\":%.10g,\"avg_response\":%.10g,\"avg_throughput\":%.10g}\n",
+                  policy, num_runs, totals->avg_turnaround / num_runs, totals->avg_wait / num_runs,
+                  totals->avg_response / num_runs, totals->throughput / num_runs);
+}
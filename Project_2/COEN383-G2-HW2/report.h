@@ -0,0 +1,48 @@
+#ifndef REPORT_H
+#define REPORT_H
+
+#include <stdio.h>
+#include "process.h"
+#include "proc_table.h"
+
+// Buffered output for the result tables. Text is collected in one large
+// buffer and handed to the FILE in big chunks, so a million-row table costs
+// a handful of writes, and rows are formatted without going through printf
+// where that matters. Because it flushes into the same FILE, output stays in
+// order with anything else printed to it.
+
+typedef enum {
+    FORMAT_TEXT,    // The human-readable tables
+    FORMAT_CSV,     // One header line, then one row per process (or per summary)
+    FORMAT_JSONL    // One JSON object per line, tagged with "type"
+} ReportFormat;
+
+typedef struct {
+    FILE *out;
+    char *buf;
+    size_t len;
+    size_t capacity;
+} Report;
+
+void report_init(Report *r, FILE *out, size_t capacity);
+void report_free(Report *r);    // Flushes first
+void report_flush(Report *r);
+void report_write(Report *r, const char *s, size_t n);
+void report_printf(Report *r, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+
+// Same text as printf("%*.1f", width, value)
+void report_fixed1(Report *r, double value, int width);
+
+// One row of the per-process results table: p's inputs with the times in res
+void report_process_row(Report *r, const Process *p, const ProcResult *res);
+
+// Machine-readable records. scope is "all" or "priority1".."priority4".
+void report_csv_process_header(Report *r);
+void report_csv_process(Report *r, int run, const char *policy, const Process *p, const ProcResult *res);
+void report_csv_summary_header(Report *r);
+void report_csv_summary(Report *r, int run, const char *policy, const char *scope, const Metrics *m);
+void report_jsonl_process(Report *r, int run, const char *policy, const Process *p, const ProcResult *res);
+void report_jsonl_summary(Report *r, int run, const char *policy, const char *scope, const Metrics *m);
+void report_jsonl_final(Report *r, const char *policy, int num_runs, const Metrics *totals);
+
+#endif
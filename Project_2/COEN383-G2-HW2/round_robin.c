@@ -1,87 +1,70 @@
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include "process.h"
+#include "sim_engine.h"
+#include "policies.h"
+#include "ready_queue.h"
 
-#define TIME_QUANTUM 1.0
+typedef struct {
+    Sim *sim;
+    FifoRing ready;
+} RRState;
 
-Metrics round_robin(Process processes[], int num_processes, char (*timeline)[10]) {
-    double current_time = 0.0;
-    int completed = 0;
-    int current_index = 0;
-   
-    while (completed < num_processes) {
-        int found = 0;
-        int checked = 0;
-       
-        // Round-robin: check processes starting from current_index
-        while (checked < num_processes) {
-            int i = (current_index + checked) % num_processes;
-           
-            if (!processes[i].completed &&
-                processes[i].arrival_time <= current_time) {
-                Process *p = &processes[i];
-               
-                // Don't start new process after quantum 99
-                if (p->start_time < 0.0 && current_time > 99.0) {
-                    checked++;
-                    continue;
-                }
-               
-                found = 1;
-               
-                // Record start time on first run
-                if (p->start_time < 0.0) {
-                    p->start_time = current_time;
-                    p->response_time = current_time - p->arrival_time;
-                }
-               
-                // Execute for time quantum or remaining time
-                double exec_time = (p->remaining_time < TIME_QUANTUM) ?
-                                  p->remaining_time : TIME_QUANTUM;
-               
-                current_time += exec_time;
-                p->remaining_time -= exec_time;
-               
-                // Check if completed
-                if (p->remaining_time < 0.01) {
-                    p->finish_time = current_time;
-                    p->turnaround_time = p->finish_time - p->arrival_time;
-                    p->wait_time = p->turnaround_time - p->service_time;
-                    p->completed = 1;
-                    completed++;
-                }
-               
-                current_index = (i + 1) % num_processes;
-                break;
-            }
-            checked++;
-        }
-       
-        if (!found) {
-            // No process ready, advance time
-            current_time += 1.0;
-           
-            // Check if we should stop
-            int has_future = 0;
-            for (int i = 0; i < num_processes; i++) {
-                if (!processes[i].completed && processes[i].arrival_time > current_time) {
-                    has_future = 1;
-                    break;
-                }
-            }
-           
-            // Also check if there are any started processes still running
-            int has_started = 0;
-            for (int i = 0; i < num_processes; i++) {
-                if (!processes[i].completed && processes[i].start_time >= 0.0) {
-                    has_started = 1;
-                    break;
-                }
-            }
-           
-            if (!has_future && !has_started) break;
-        }
+static void *rr_init(Sim *sim) {
+    RRState *s = (RRState *)malloc(sizeof(RRState));
+    s->sim = sim;
+    fifo_ring_init(&s->ready, sim->num_processes);
+    return s;
+}
+
+static void rr_destroy(void *state) {
+    RRState *s = (RRState *)state;
+    fifo_ring_free(&s->ready);
+    free(s);
+}
+
+static void rr_on_arrival(void *state, int pid) {
+    RRState *s = (RRState *)state;
+    fifo_ring_push(&s->ready, pid);
+}
+
+static int rr_pick_next(void *state) {
+    RRState *s = (RRState *)state;
+
+    while (!fifo_ring_empty(&s->ready)) {
+        int pid = fifo_ring_pop(&s->ready);
+
+        // Don't start new process after the cutoff (quantum 99 by default). The clock only moves
+        // forward, so it can never start and is dropped from the queue.
+        if (sim_too_late(s->sim, pid)) continue;
+
+        return pid;
     }
-   
-    return calculate_metrics(processes, num_processes);
+
+    return SIM_IDLE;
+}
+
+static void rr_on_preempt(void *state, int pid) {
+    RRState *s = (RRState *)state;
+
+    // Behind everything already waiting, including arrivals during the slice
+    fifo_ring_push(&s->ready, pid);
+}
+
+// Execute for time quantum or remaining time
+static double rr_quantum_of(void *state, int pid) {
+    (void)state;
+    (void)pid;
+    return sched_config.rr_quantum;
 }
+
+const SchedOps rr_ops = {
+    .quantum = 1.0,
+    .init = rr_init,
+    .destroy = rr_destroy,
+    .on_arrival = rr_on_arrival,
+    .pick_next = rr_pick_next,
+    .on_preempt = rr_on_preempt,
+    .quantum_of = rr_quantum_of,
+};
@@ -0,0 +1,338 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "sim_engine.h"
+
+#define IDLE_JUMP_TICKS 1024.0
+
+static int event_before(const Event *a, const Event *b) {
+    if (a->time != b->time) return a->time < b->time;
+    return a->type < b->type;
+}
+
+void event_queue_init(EventQueue *q, int capacity) {
+    q->events = (Event *)malloc(sizeof(Event) * capacity);
+    q->size = 0;
+    q->capacity = capacity;
+}
+
+void event_queue_free(EventQueue *q) {
+    free(q->events);
+    q->events = NULL;
+    q->size = 0;
+    q->capacity = 0;
+}
+
+void event_queue_push(EventQueue *q, Event ev) {
+    if (q->size == q->capacity) {
+        q->capacity *= 2;
+        q->events = (Event *)realloc(q->events, sizeof(Event) * q->capacity);
+    }
+
+    // Sift up
+    int i = q->size++;
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (!event_before(&ev, &q->events[parent])) break;
+        q->events[i] = q->events[parent];
+        i = parent;
+    }
+    q->events[i] = ev;
+}
+
+Event event_queue_pop(EventQueue *q) {
+    Event top = q->events[0];
+    Event last = q->events[--q->size];
+
+    // Sift down
+    int i = 0;
+    while (1) {
+        int child = 2 * i + 1;
+        if (child >= q->size) break;
+        if (child + 1 < q->size && event_before(&q->events[child + 1], &q->events[child])) {
+            child++;
+        }
+        if (!event_before(&q->events[child], &last)) break;
+        q->events[i] = q->events[child];
+        i = child;
+    }
+    if (q->size > 0) q->events[i] = last;
+
+    return top;
+}
+
+int sim_too_late(const Sim *sim, int pid) {
+    return sim->table->start[pid] < 0.0 && sim->current_time > sched_config.start_cutoff;
+}
+
+// Only the next arrival sits in the queue; the rest are read from the sorted
+// array as each one is handled, so the heap stays small for huge workloads.
+static void schedule_next_arrival(Sim *sim) {
+    if (sim->next_arrival < sim->num_processes) {
+        Event ev = {sim->table->arrival[sim->next_arrival], EV_ARRIVAL, sim->next_arrival, -1};
+        event_queue_push(&sim->events, ev);
+    }
+}
+
+static void record_completion(Sim *sim, int pid) {
+    ProcTable *t = sim->table;
+
+    t->finish[pid] = sim->current_time;
+    t->completed[pid] = 1;
+    sim->completed++;
+    sim->in_progress--;
+
+    if (t->start[pid] <= sched_config.start_cutoff) {
+        double turnaround = t->finish[pid] - t->arrival[pid];
+        latency_stats_record(sim->latency, t->priority[pid], turnaround,
+                             turnaround - t->service[pid], t->start[pid] - t->arrival[pid]);
+    }
+}
+
+// Core that a new arrival queues on: pid % cores with affinity, otherwise the
+// core with the least work (queued plus running), lowest index on ties
+static int place_arrival(const Sim *sim, int pid) {
+    if (sim->num_cores == 1) return 0;
+    if (sched_config.affinity) return pid % sim->num_cores;
+
+    int best = -1;
+    int best_load = 0;
+    for (int c = 0; c < sim->num_cores; c++) {
+        const Core *core = &sim->cores[c];
+        if (core->retired) continue;
+
+        int load = core->queued + (core->running != -1);
+        if (best == -1 || load < best_load) {
+            best = c;
+            best_load = load;
+        }
+    }
+    return (best == -1) ? 0 : best;
+}
+
+static void handle_event(Sim *sim, const SchedOps *ops, Event ev) {
+    sim->current_time = ev.time;
+    sim->events_handled++;
+
+    switch (ev.type) {
+    case EV_ARRIVAL: {
+        Core *home = &sim->cores[place_arrival(sim, ev.pid)];
+        sim->next_arrival++;
+        home->queued++;
+        ops->on_arrival(home->state, ev.pid);
+        schedule_next_arrival(sim);
+        break;
+    }
+    case EV_QUANTUM_EXPIRY: {
+        // Back to the queue it was picked from, which may be another core's if it was stolen
+        Core *from = &sim->cores[sim->cores[ev.core].running_from];
+        sim->cores[ev.core].running = -1;
+        from->queued++;
+        ops->on_preempt(from->state, ev.pid);
+        break;
+    }
+    case EV_COMPLETION:
+        sim->cores[ev.core].running = -1;
+        record_completion(sim, ev.pid);
+        break;
+    }
+}
+
+// Handle every arrival up to the current time
+static void admit_arrivals(Sim *sim, const SchedOps *ops) {
+    double now = sim->current_time;
+    while (sim->events.size > 0 && sim->events.events[0].time <= now) {
+        handle_event(sim, ops, event_queue_pop(&sim->events));
+    }
+    sim->current_time = now;
+}
+
+// Nothing is ready: move the clock to the first tick at or after the next
+// arrival. Ticking with += 1.0 (no per-tick scan) keeps the clock bit-for-bit
+// the same as a per-quantum loop would have it; only gaps longer than
+// IDLE_JUMP_TICKS, as found in long traces, are crossed in one addition.
+// Returns 0, without moving the clock, when nothing is left to arrive.
+static int skip_idle(Sim *sim) {
+    if (sim->next_arrival >= sim->num_processes) return 0;
+
+    double arrival = sim->table->arrival[sim->next_arrival];
+    double gap = floor(arrival - sim->current_time);
+    if (gap > IDLE_JUMP_TICKS) {
+        sim->current_time += gap - 1.0;
+    }
+    do {
+        sim->current_time += 1.0;
+    } while (sim->current_time < arrival);
+
+    return 1;
+}
+
+// Next process for free core c: from its own queue, else (without affinity)
+// stolen from the core with the most queued work. A pick that finds a queue
+// empty resets that core's count, which may include entries RR dropped.
+static int pick_for_core(Sim *sim, const SchedOps *ops, int c) {
+    Core *core = &sim->cores[c];
+
+    int pid = ops->pick_next(core->state);
+    if (pid >= 0) {
+        core->queued--;
+        core->running_from = c;
+        return pid;
+    }
+    if (pid == SIM_STOP) {
+        core->retired = 1;
+        return SIM_STOP;
+    }
+    core->queued = 0;
+
+    if (sim->num_cores == 1 || sched_config.affinity) return SIM_IDLE;
+
+    int victim = -1;
+    for (int v = 0; v < sim->num_cores; v++) {
+        if (v != c && sim->cores[v].queued > 0 &&
+            (victim == -1 || sim->cores[v].queued > sim->cores[victim].queued)) {
+            victim = v;
+        }
+    }
+    if (victim == -1) return SIM_IDLE;
+
+    // SIM_STOP here is the victim's own business; the thief just stays idle
+    pid = ops->pick_next(sim->cores[victim].state);
+    if (pid < 0) {
+        if (pid == SIM_IDLE) sim->cores[victim].queued = 0;
+        return SIM_IDLE;
+    }
+
+    sim->cores[victim].queued--;
+    core->running_from = victim;
+    sim->steals++;
+    return pid;
+}
+
+static void dispatch(Sim *sim, const SchedOps *ops, int c, int pid) {
+    ProcTable *t = sim->table;
+    Core *core = &sim->cores[c];
+
+    // Switching to a different process costs the configured overhead first
+    double begin = sim->current_time;
+    if (core->last_pid != -1 && core->last_pid != pid) {
+        begin += sched_config.context_switch;
+        sim->context_switches++;
+    }
+    core->last_pid = pid;
+    core->running = pid;
+
+    // Record start time on first run
+    if (t->start[pid] < 0.0) {
+        t->start[pid] = begin;
+        sim->in_progress++;
+    }
+
+    double quantum = ops->quantum;
+    if (ops->quantum_of != NULL) {
+        quantum = ops->quantum_of(sim->cores[core->running_from].state, pid);
+    }
+
+    double exec_time = t->remaining[pid];
+    if (quantum > 0.0 && exec_time > quantum) {
+        exec_time = quantum;
+    }
+    t->remaining[pid] -= exec_time;
+    core->busy_time += exec_time;
+
+    if (sim->timeline != NULL) {
+        timeline_append(sim->timeline, c, pid, begin, begin + exec_time);
+    }
+
+    Event ev = {begin + exec_time, EV_QUANTUM_EXPIRY, pid, c};
+    if (quantum <= 0.0 || t->remaining[pid] < 0.01) {
+        ev.type = EV_COMPLETION;
+    }
+    event_queue_push(&sim->events, ev);
+}
+
+HPFMetrics sim_run(ProcTable *table, const SchedOps *ops, Timeline *timeline) {
+    int num_processes = table->num_processes;
+    proc_table_reset(table);
+
+    Sim sim;
+    sim.table = table;
+    sim.num_processes = num_processes;
+    sim.current_time = 0.0;
+    sim.completed = 0;
+    sim.in_progress = 0;
+    sim.next_arrival = 0;
+    sim.context_switches = 0;
+    sim.steals = 0;
+    sim.events_handled = 0;
+    for (int i = 0; i < POLICY_COUNTERS; i++) sim.counters[i] = 0.0;
+    event_queue_init(&sim.events, 4);
+    sim.latency = (LatencyStats *)calloc(1, sizeof(LatencyStats));
+    sim.timeline = timeline;
+    if (timeline != NULL) timeline_clear(timeline);
+
+    // Every core gets its own instance of the policy's ready queue
+    sim.num_cores = (sched_config.num_cores > 0) ? sched_config.num_cores : 1;
+    sim.cores = (Core *)malloc(sizeof(Core) * sim.num_cores);
+    for (int c = 0; c < sim.num_cores; c++) {
+        Core *core = &sim.cores[c];
+        core->running = -1;
+        core->running_from = c;
+        core->last_pid = -1;
+        core->queued = 0;
+        core->retired = 0;
+        core->busy_time = 0.0;
+        core->state = ops->init(&sim);
+    }
+
+    schedule_next_arrival(&sim);
+    admit_arrivals(&sim, ops);
+
+    while (sim.completed < num_processes) {
+        int busy = 0;
+        int retired = 0;
+
+        for (int c = 0; c < sim.num_cores; c++) {
+            Core *core = &sim.cores[c];
+            if (!core->retired && core->running == -1) {
+                int pid = pick_for_core(&sim, ops, c);
+                if (pid >= 0) dispatch(&sim, ops, c, pid);
+            }
+            busy += (core->running != -1);
+            retired += core->retired;
+        }
+
+        if (busy == 0) {
+            // Every core hit the cutoff, or every queue is empty and nothing
+            // is left to arrive; otherwise admit whoever arrived in the gap
+            if (retired == sim.num_cores || !skip_idle(&sim)) break;
+            admit_arrivals(&sim, ops);
+            continue;
+        }
+
+        // Run until some slice ends, handling arrivals on the way
+        handle_event(&sim, ops, event_queue_pop(&sim.events));
+    }
+
+    double busy_time = 0.0;
+    for (int c = 0; c < sim.num_cores; c++) {
+        busy_time += sim.cores[c].busy_time;
+        ops->destroy(sim.cores[c].state);
+    }
+    free(sim.cores);
+    event_queue_free(&sim.events);
+
+    HPFMetrics metrics = proc_table_metrics(table);
+    latency_stats_fill(sim.latency, &metrics);
+    free(sim.latency);
+
+    metrics.overall.context_switches = sim.context_switches;
+    metrics.overall.steals = sim.steals;
+    metrics.overall.events = (double)sim.events_handled;
+    for (int i = 0; i < POLICY_COUNTERS; i++) metrics.overall.counters[i] = sim.counters[i];
+    if (sim.current_time > 0.0) {
+        metrics.overall.utilization = busy_time / (sim.num_cores * sim.current_time);
+    }
+
+    return metrics;
+}
@@ -0,0 +1,88 @@
+#ifndef SIM_ENGINE_H
+#define SIM_ENGINE_H
+
+#include "process.h"
+#include "proc_table.h"
+#include "histogram.h"
+#include "timeline.h"
+
+// Event kinds. When two events share a timestamp the lower kind is handled
+// first, so a process arriving exactly as a slice ends is visible to the next pick.
+typedef enum {
+    EV_ARRIVAL,
+    EV_QUANTUM_EXPIRY,
+    EV_COMPLETION
+} EventType;
+
+typedef struct {
+    double time;
+    EventType type;
+    int pid;   // Index into the process array
+    int core;  // CPU the slice ran on, -1 for arrivals
+} Event;
+
+// Binary min-heap of pending events ordered by (time, type)
+typedef struct {
+    Event *events;
+    int size;
+    int capacity;
+} EventQueue;
+
+void event_queue_init(EventQueue *q, int capacity);
+void event_queue_free(EventQueue *q);
+void event_queue_push(EventQueue *q, Event ev);
+Event event_queue_pop(EventQueue *q);
+
+// Special return values of pick_next
+#define SIM_IDLE -1  // Nothing is ready, let the CPU idle until the next arrival
+#define SIM_STOP -2  // End the run now
+
+typedef struct {
+    void *state;          // This core's instance of the policy's ready queue
+    int running;          // pid on this CPU, -1 when free
+    int running_from;     // Core whose queue running was picked from (differs when stolen)
+    int last_pid;         // Process this CPU ran last, -1 before its first dispatch
+    int queued;           // Processes waiting in this core's queue, used to place and steal work
+    int retired;          // The policy said SIM_STOP: this core starts nothing more
+    double busy_time;
+} Core;
+
+typedef struct {
+    ProcTable *table;     // Sorted by arrival time
+    int num_processes;
+    double current_time;
+    int completed;
+    int in_progress;      // Started but not yet completed
+    int next_arrival;     // Arrival cursor: processes[0..next_arrival) have arrived
+    int num_cores;
+    Core *cores;
+    int context_switches;
+    int steals;           // Picks a free core made from another core's queue
+    long events_handled;
+    double counters[POLICY_COUNTERS];  // Policy-specific counts, summed over cores
+    EventQueue events;
+    LatencyStats *latency;  // Filled at each completion that counts toward the metrics
+    Timeline *timeline;     // Intervals the CPU ran, NULL when not recorded
+} Sim;
+
+// Hooks a scheduling policy plugs into the engine. The engine owns the clock,
+// arrivals and dispatching; the policy only owns its ready queue. With several
+// cores, init runs once per core and each hook gets that core's state.
+typedef struct {
+    double quantum;                             // Slice length, 0 = run to completion
+    void *(*init)(Sim *sim);                    // Allocate the policy's ready queue
+    void (*destroy)(void *state);
+    void (*on_arrival)(void *state, int pid);   // pid just arrived
+    int (*pick_next)(void *state);              // pid to dispatch, SIM_IDLE or SIM_STOP
+    void (*on_preempt)(void *state, int pid);   // pid's slice expired with work left
+    double (*quantum_of)(void *state, int pid); // Optional: slice for the pid just picked,
+                                                // overriding quantum (NULL = use quantum)
+} SchedOps;
+
+// Run one policy over the workload loaded in table: its run columns are reset
+// first and hold the per-process results afterwards (see proc_table_result).
+// If timeline is not NULL it is cleared and receives the run's CPU intervals.
+HPFMetrics sim_run(ProcTable *table, const SchedOps *ops, Timeline *timeline);
+int sim_too_late(const Sim *sim, int pid);
+
+#endif
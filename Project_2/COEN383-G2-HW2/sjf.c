@@ -1,75 +1,70 @@
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include "process.h"
+#include "sim_engine.h"
+#include "policies.h"
+#include "ready_queue.h"
 
-// Output: Metrics structure containing average turnaround time, wait time, response time, and throughput of the processes
-Metrics sjf(Process processes[], int num_processes, char (*timeline)[10])
+typedef struct
 {
-    double current_time = 0.0;
-    int completed = 0;
+    Sim *sim;
+    ReadyHeap ready; // Arrived processes keyed on service_time
+} SJFState;
 
-    while (completed < num_processes)
-    {
+static void *sjf_init(Sim *sim)
+{
+    SJFState *s = (SJFState *)malloc(sizeof(SJFState));
+    s->sim = sim;
+    ready_heap_init(&s->ready, sim->num_processes);
+    return s;
+}
 
-        // Find shortest job that has arrived
-        int next_process = -1;
-        double shortest_time = 1000.0;
+static void sjf_destroy(void *state)
+{
+    SJFState *s = (SJFState *)state;
+    ready_heap_free(&s->ready);
+    free(s);
+}
 
-        for (int i = 0; i < num_processes; i++)
-        {
-            if (!processes[i].completed &&
-                processes[i].arrival_time <= current_time &&
-                processes[i].service_time < shortest_time)
-            {
-                shortest_time = processes[i].service_time;
-                next_process = i;
-            }
-        }
+static void sjf_on_arrival(void *state, int pid)
+{
+    SJFState *s = (SJFState *)state;
+    ready_heap_push(&s->ready, s->sim->table->service[pid], pid);
+}
 
-        if (next_process != -1)
-        {
-            Process *p = &processes[next_process];
+static int sjf_pick_next(void *state)
+{
+    SJFState *s = (SJFState *)state;
 
-            // Don't start new process after quantum 99
-            if (current_time > 99.0)
-            {
-                break;
-            }
+    if (ready_heap_empty(&s->ready))
+    {
+        return SIM_IDLE;
+    }
 
-            // Record start time if first run
-            if (p->start_time < 0.0)
-            {
-                p->start_time = current_time;
-                p->response_time = current_time - p->arrival_time;
-            }
+    // Don't start new process after the cutoff (quantum 99 by default)
+    if (sim_too_late(s->sim, ready_heap_peek(&s->ready)))
+    {
+        return SIM_STOP;
+    }
 
-            // Execute the process completely
-            current_time += p->service_time; // *
-            p->finish_time = current_time;
-            p->turnaround_time = p->finish_time - p->arrival_time;
-            p->wait_time = p->turnaround_time - p->service_time;
-            p->completed = 1;
-            completed++;
-        }
-        else
-        {
-            // No process ready, advance time
-            current_time += 1.0;
+    // The heap top is the shortest job that has arrived
+    return ready_heap_pop(&s->ready);
+}
 
-            // Check if we should stop
-            int has_future = 0;
-            for (int i = 0; i < num_processes; i++)
-            {
-                if (!processes[i].completed && processes[i].arrival_time > current_time)
-                {
-                    has_future = 1;
-                    break;
-                }
-            }
-            if (!has_future)
-                break;
-        }
-    }
+static void sjf_on_preempt(void *state, int pid)
+{
+    // Non-preemptive
+    (void)state;
+    (void)pid;
+}
 
-    return calculate_metrics(processes, num_processes);
-}
\ No newline at end of file
+const SchedOps sjf_ops = {
+    .quantum = 0.0,
+    .init = sjf_init,
+    .destroy = sjf_destroy,
+    .on_arrival = sjf_on_arrival,
+    .pick_next = sjf_pick_next,
+    .on_preempt = sjf_on_preempt,
+    .quantum_of = NULL,
+};
@@ -1,80 +1,70 @@
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include "process.h"
+#include "sim_engine.h"
+#include "policies.h"
+#include "ready_queue.h"
 
-Metrics srt(Process processes[], int num_processes, char (*timeline)[10])
+typedef struct
 {
-    double current_time = 0.0;
-    int completed = 0;
+    Sim *sim;
+    ReadyHeap ready; // Arrived processes keyed on remaining_time
+} SRTState;
 
-    while (completed < num_processes)
-    {
-        int next_process = -1;
-        double shortest_remaining = 1000.0;
+static void *srt_init(Sim *sim)
+{
+    SRTState *s = (SRTState *)malloc(sizeof(SRTState));
+    s->sim = sim;
+    ready_heap_init(&s->ready, sim->num_processes);
+    return s;
+}
 
-        // Find process with shortest remaining time
-        for (int i = 0; i < num_processes; i++)
-        {
-            if (!processes[i].completed &&
-                processes[i].arrival_time <= current_time &&
-                processes[i].remaining_time < shortest_remaining)
-            {
-                shortest_remaining = processes[i].remaining_time;
-                next_process = i;
-            }
-        }
+static void srt_destroy(void *state)
+{
+    SRTState *s = (SRTState *)state;
+    ready_heap_free(&s->ready);
+    free(s);
+}
 
-        if (next_process != -1)
-        {
-            Process *p = &processes[next_process];
+static void srt_on_arrival(void *state, int pid)
+{
+    SRTState *s = (SRTState *)state;
+    ready_heap_push(&s->ready, s->sim->table->remaining[pid], pid);
+}
 
-            // Don't start new process after quantum 99
-            if (p->start_time < 0.0 && current_time > 99.0)
-            {
-                break;
-            }
+static int srt_pick_next(void *state)
+{
+    SRTState *s = (SRTState *)state;
 
-            // Record start time on first run
-            if (p->start_time < 0.0)
-            {
-                p->start_time = current_time;
-                p->response_time = current_time - p->arrival_time;
-            }
+    if (ready_heap_empty(&s->ready))
+    {
+        return SIM_IDLE;
+    }
 
-            // Execute for 1 quantum
-            double exec_time = (p->remaining_time < 1.0) ? p->remaining_time : 1.0;
-            current_time += exec_time;
-            p->remaining_time -= exec_time;
+    // Don't start new process after the cutoff (quantum 99 by default)
+    if (sim_too_late(s->sim, ready_heap_peek(&s->ready)))
+    {
+        return SIM_STOP;
+    }
 
-            // Check if completed
-            if (p->remaining_time < 0.01)
-            {
-                p->finish_time = current_time;
-                p->turnaround_time = p->finish_time - p->arrival_time;
-                p->wait_time = p->turnaround_time - p->service_time;
-                p->completed = 1;
-                completed++;
-            }
-        }
-        else
-        {
-            // No process ready, advance time
-            current_time += 1.0;
+    // The heap top is the process with shortest remaining time that has arrived
+    return ready_heap_pop(&s->ready);
+}
 
-            // Check if we should stop
-            int has_future = 0;
-            for (int i = 0; i < num_processes; i++)
-            {
-                if (!processes[i].completed && processes[i].arrival_time > current_time)
-                {
-                    has_future = 1;
-                    break;
-                }
-            }
-            if (!has_future)
-                break;
-        }
-    }
+static void srt_on_preempt(void *state, int pid)
+{
+    SRTState *s = (SRTState *)state;
+    ready_heap_push(&s->ready, s->sim->table->remaining[pid], pid);
+}
 
-    return calculate_metrics(processes, num_processes);
-}
\ No newline at end of file
+// Execute for 1 quantum, then re-pick
+const SchedOps srt_ops = {
+    .quantum = 1.0,
+    .init = srt_init,
+    .destroy = srt_destroy,
+    .on_arrival = srt_on_arrival,
+    .pick_next = srt_pick_next,
+    .on_preempt = srt_on_preempt,
+    .quantum_of = NULL,
+};
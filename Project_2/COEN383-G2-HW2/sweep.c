@@ -0,0 +1,140 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "process.h"
+#include "sweep.h"
+#include "policies.h"
+
+enum {
+    STAT_TURNAROUND, STAT_WAIT, STAT_RESPONSE, STAT_THROUGHPUT,
+    STAT_TURNAROUND_P99, STAT_WAIT_P99, STAT_RESPONSE_P99, NUM_STATS
+};
+
+static const char *stat_names[NUM_STATS] = {
+    "Turnaround", "Wait", "Response", "Throughput", "TAT p99", "Wait p99", "Resp p99"
+};
+
+typedef struct {
+    const PolicyInfo *const *policies;
+    int num_policies;
+    int num_seeds;
+    int num_processes;
+    unsigned int base_seed;
+    atomic_int next_seed;               // Work counter shared by all workers
+    double *(*values)[NUM_STATS];       // values[p][s][seed]
+} SweepJob;
+
+// Each worker owns its workload and table; results go to disjoint slots, so
+// the only shared write is the seed counter.
+static void *sweep_worker(void *arg) {
+    SweepJob *job = (SweepJob *)arg;
+    Process *original = (Process *)malloc(sizeof(Process) * job->num_processes);
+    ProcTable table;
+    proc_table_init(&table, job->num_processes);
+
+    while (1) {
+        int seed = atomic_fetch_add(&job->next_seed, 1);
+        if (seed >= job->num_seeds) break;
+
+        generate_workload(original, job->num_processes, job->base_seed + seed);
+        proc_table_load(&table, original);
+
+        for (int p = 0; p < job->num_policies; p++) {
+            Metrics m = sim_run(&table, job->policies[p]->ops, NULL).overall;
+
+            job->values[p][STAT_TURNAROUND][seed] = m.avg_turnaround;
+            job->values[p][STAT_WAIT][seed] = m.avg_wait;
+            job->values[p][STAT_RESPONSE][seed] = m.avg_response;
+            job->values[p][STAT_THROUGHPUT][seed] = m.throughput;
+            job->values[p][STAT_TURNAROUND_P99][seed] = m.turnaround_pct.p99;
+            job->values[p][STAT_WAIT_P99][seed] = m.wait_pct.p99;
+            job->values[p][STAT_RESPONSE_P99][seed] = m.response_pct.p99;
+        }
+    }
+
+    free(original);
+    proc_table_free(&table);
+    return NULL;
+}
+
+static int compare_double(const void *a, const void *b) {
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// Nearest-rank percentile of a sorted array
+static double percentile(const double *sorted, int n, double pct) {
+    int rank = (int)ceil(pct / 100.0 * n);
+    if (rank < 1) rank = 1;
+    if (rank > n) rank = n;
+    return sorted[rank - 1];
+}
+
+static void print_aggregate(const char *metric, double *values, int n) {
+    double sum = 0.0;
+    for (int i = 0; i < n; i++) sum += values[i];
+    double mean = sum / n;
+
+    double sq = 0.0;
+    for (int i = 0; i < n; i++) sq += (values[i] - mean) * (values[i] - mean);
+    double stddev = (n > 1) ? sqrt(sq / (n - 1)) : 0.0;
+
+    qsort(values, n, sizeof(double), compare_double);
+
+    printf("  %-10s | %8.2f | %8.2f | %8.2f | %8.2f | %8.2f | %8.2f\n",
+           metric, mean, stddev, percentile(values, n, 50.0),
+           percentile(values, n, 95.0), percentile(values, n, 99.0), values[n - 1]);
+}
+
+void run_sweep(const PolicyInfo *const policies[], int num_policies,
+               int num_seeds, int num_threads, int num_processes, unsigned int base_seed) {
+    SweepJob job;
+    job.policies = policies;
+    job.num_policies = num_policies;
+    job.num_seeds = num_seeds;
+    job.num_processes = num_processes;
+    job.base_seed = base_seed;
+    atomic_init(&job.next_seed, 0);
+    job.values = malloc(sizeof(*job.values) * num_policies);
+    for (int p = 0; p < num_policies; p++) {
+        for (int s = 0; s < NUM_STATS; s++) {
+            job.values[p][s] = (double *)malloc(sizeof(double) * num_seeds);
+        }
+    }
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    pthread_t *tids = (pthread_t *)malloc(sizeof(pthread_t) * num_threads);
+    for (int t = 0; t < num_threads; t++) {
+        pthread_create(&tids[t], NULL, sweep_worker, &job);
+    }
+    for (int t = 0; t < num_threads; t++) {
+        pthread_join(tids[t], NULL);
+    }
+    free(tids);
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+
+    printf("SWEEP: %d seeds (%u-%u) x %d policies, %d processes each, %d threads, %.3f s\n\n",
+           num_seeds, base_seed, base_seed + num_seeds - 1, num_policies,
+           num_processes, num_threads, elapsed);
+
+    for (int p = 0; p < num_policies; p++) {
+        printf("%s:\n", policies[p]->name);
+        printf("  %-10s | %8s | %8s | %8s | %8s | %8s | %8s\n",
+               "metric", "mean", "stddev", "p50", "p95", "p99", "max");
+        for (int s = 0; s < NUM_STATS; s++) {
+            print_aggregate(stat_names[s], job.values[p][s], num_seeds);
+            free(job.values[p][s]);
+        }
+        printf("\n");
+    }
+    free(job.values);
+}
@@ -0,0 +1,11 @@
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include "policies.h"
+
+// Run each of policies on num_seeds workloads (seeds base_seed, base_seed + 1, ...)
+// spread over num_threads workers, then print mean/stddev/percentiles per policy.
+void run_sweep(const PolicyInfo *const policies[], int num_policies,
+               int num_seeds, int num_threads, int num_processes, unsigned int base_seed);
+
+#endif
@@ -0,0 +1,127 @@
+// Trace replay regression test: runs every registered policy on small CSV
+// traces and checks that each job finishes when it should. Covers idle gaps
+// between arrivals, which once ended runs early and dropped the later jobs,
+// and malformed lines the loader must reject rather than guess at.
+// Build and run from COEN383-G2-HW2:
+//
+//   gcc -O2 -pthread -I. -o trace_replay tests/trace_replay.c $(ls *.c | grep -v '^main.c$') -lm
+//   ./trace_replay
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <unistd.h>
+#include "process.h"
+#include "policies.h"
+#include "trace.h"
+
+typedef struct {
+    const char *name;
+    const char *csv;
+    int cores;
+    double finish[4];   // Expected finish time of each job, in file order
+} ReplayCase;
+
+// Jobs finish one after another whatever the policy, so the finish times
+// hold for all of them
+static const ReplayCase cases[] = {
+    {"idle gap before the last job", "0,1,1\n10,1,2\n", 1, {1, 11}},
+    {"idle gap, last job arrives between ticks", "0,1,1\n10.5,1,2\n", 1, {1, 12}},
+    {"two idle gaps", "0,2,1\n5,1,2\n20,3,3\n", 1, {2, 6, 23}},
+    {"idle gap on two cores", "0,1,1\n0,1,2\n10,1,3\n", 2, {1, 1, 11}},
+};
+
+#define NUM_CASES (int)(sizeof(cases) / sizeof(cases[0]))
+
+// Traces load_trace must refuse
+static const char *bad_traces[] = {
+    "0,1,1\n,5,2\n",               // missing arrival
+    "0,1,1\n1,2,3xyz\n",           // trailing garbage
+    "0,1,1\n1,2,4294967297\n",     // priority that wraps to 1 as an int
+    "0,1,1\n1,2\n",                // missing priority
+    "0,1,1\n1,inf,2\n",            // endless burst
+};
+
+#define NUM_BAD_TRACES (int)(sizeof(bad_traces) / sizeof(bad_traces[0]))
+
+// Load csv through a temporary file, as --trace would
+static Process *load_csv(const char *csv, int *num_processes) {
+    char path[] = "/tmp/trace_replay_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) return NULL;
+
+    FILE *file = fdopen(fd, "w");
+    fputs(csv, file);
+    fclose(file);
+
+    Process *processes = load_trace(path, num_processes);
+    unlink(path);
+    return processes;
+}
+
+static int run_replay(const ReplayCase *c) {
+    int n;
+    Process *processes = load_csv(c->csv, &n);
+    if (processes == NULL) {
+        printf("FAIL %s: cannot load trace\n", c->name);
+        return 0;
+    }
+
+    ProcTable table;
+    proc_table_init(&table, n);
+    proc_table_load(&table, processes);
+    sched_config.num_cores = c->cores;
+
+    int ok = 1;
+    for (int p = 0; p < num_registered_policies; p++) {
+        const PolicyInfo *policy = &policy_registry[p];
+        Metrics m = sim_run(&table, policy->ops, NULL).overall;
+
+        if (m.throughput != n) {
+            printf("FAIL %s, %s: %.0f of %d jobs completed\n", c->name, policy->name, m.throughput, n);
+            ok = 0;
+            continue;
+        }
+        for (int pid = 0; pid < n; pid++) {
+            ProcResult r = proc_table_result(&table, pid);
+            if (fabs(r.finish - c->finish[pid]) > 1e-9) {
+                printf("FAIL %s, %s: job %d finished at %.1f, expected %.1f\n",
+                       c->name, policy->name, pid + 1, r.finish, c->finish[pid]);
+                ok = 0;
+            }
+        }
+    }
+
+    proc_table_free(&table);
+    free(processes);
+    return ok;
+}
+
+int main(void) {
+    // As with --trace: no cutoff, every job runs
+    sched_config.start_cutoff = HUGE_VAL;
+
+    int failed = 0;
+    for (int i = 0; i < NUM_CASES; i++) {
+        if (run_replay(&cases[i])) {
+            printf("ok   %s\n", cases[i].name);
+        } else {
+            failed++;
+        }
+    }
+
+    for (int i = 0; i < NUM_BAD_TRACES; i++) {
+        int n;
+        Process *processes = load_csv(bad_traces[i], &n);
+        if (processes != NULL) {
+            printf("FAIL bad trace %d: loaded %d jobs\n", i + 1, n);
+            free(processes);
+            failed++;
+        } else {
+            printf("ok   bad trace %d rejected\n", i + 1);
+        }
+    }
+
+    printf("%d of %d cases passed\n", NUM_CASES + NUM_BAD_TRACES - failed, NUM_CASES + NUM_BAD_TRACES);
+    return failed > 0;
+}
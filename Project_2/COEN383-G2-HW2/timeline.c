@@ -0,0 +1,123 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "timeline.h"
+
+#define RECORD_CHUNK 4096
+
+void timeline_init(Timeline *tl) {
+    tl->capacity = 64;
+    tl->intervals = (Interval *)malloc(sizeof(Interval) * tl->capacity);
+    tl->count = 0;
+    tl->last = NULL;
+    tl->num_cores = 0;
+}
+
+void timeline_free(Timeline *tl) {
+    free(tl->intervals);
+    free(tl->last);
+    tl->intervals = NULL;
+    tl->last = NULL;
+    tl->count = 0;
+    tl->capacity = 0;
+    tl->num_cores = 0;
+}
+
+void timeline_clear(Timeline *tl) {
+    tl->count = 0;
+    for (int c = 0; c < tl->num_cores; c++) tl->last[c] = -1;
+}
+
+void timeline_append(Timeline *tl, int core, int pid, double start, double end) {
+    if (core >= tl->num_cores) {
+        tl->last = (int *)realloc(tl->last, sizeof(int) * (core + 1));
+        for (int c = tl->num_cores; c <= core; c++) tl->last[c] = -1;
+        tl->num_cores = core + 1;
+    }
+
+    if (tl->last[core] != -1) {
+        Interval *last = &tl->intervals[tl->last[core]];
+        if (last->pid == pid && last->end == start) {
+            last->end = end;
+            return;
+        }
+    }
+
+    if (tl->count == tl->capacity) {
+        tl->capacity *= 2;
+        tl->intervals = (Interval *)realloc(tl->intervals, sizeof(Interval) * tl->capacity);
+    }
+    tl->last[core] = tl->count;
+    Interval *iv = &tl->intervals[tl->count++];
+    iv->pid = pid;
+    iv->core = core;
+    iv->start = start;
+    iv->end = end;
+}
+
+int timeline_writer_open(TimelineWriter *w, const char *path) {
+    size_t len = strlen(path);
+    w->binary = len >= 4 && strcmp(path + len - 4, ".bin") == 0;
+    w->file = fopen(path, w->binary ? "wb" : "w");
+    if (w->file == NULL) {
+        printf("Error: cannot create timeline %s\n", path);
+        return 0;
+    }
+    return 1;
+}
+
+static int write_binary(FILE *file, const char *policy, int run,
+                        const Timeline *tl, const Process processes[]) {
+    TimelineHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, TIMELINE_MAGIC, sizeof(header.magic));
+    header.version = TIMELINE_VERSION;
+    header.record_size = sizeof(TimelineRecord);
+    header.count = tl->count;
+    strncpy(header.policy, policy, sizeof(header.policy) - 1);
+    header.run = run;
+    if (fwrite(&header, sizeof(header), 1, file) != 1) return 0;
+
+    // Convert in fixed-size chunks so huge runs don't need a second full copy
+    TimelineRecord records[RECORD_CHUNK];
+    for (int base = 0; base < tl->count; base += RECORD_CHUNK) {
+        int n = tl->count - base;
+        if (n > RECORD_CHUNK) n = RECORD_CHUNK;
+
+        for (int i = 0; i < n; i++) {
+            const Interval *iv = &tl->intervals[base + i];
+            records[i].start = iv->start;
+            records[i].end = iv->end;
+            records[i].process_id = processes[iv->pid].id;
+            records[i].core = iv->core;
+        }
+        if (fwrite(records, sizeof(TimelineRecord), n, file) != (size_t)n) return 0;
+    }
+    return 1;
+}
+
+static int write_text(FILE *file, const char *policy, int run,
+                      const Timeline *tl, const Process processes[]) {
+    fprintf(file, "# %s iteration %d\n", policy, run);
+    for (int i = 0; i < tl->count; i++) {
+        const Interval *iv = &tl->intervals[i];
+        fprintf(file, "%s,%.3f,%.3f,%d\n", processes[iv->pid].name, iv->start, iv->end, iv->core);
+    }
+    return !ferror(file);
+}
+
+int timeline_write(TimelineWriter *w, const char *policy, int run,
+                   const Timeline *tl, const Process processes[]) {
+    int ok = w->binary ? write_binary(w->file, policy, run, tl, processes)
+                       : write_text(w->file, policy, run, tl, processes);
+    if (!ok) printf("Error: failed writing timeline\n");
+    return ok;
+}
+
+int timeline_writer_close(TimelineWriter *w) {
+    if (fclose(w->file) != 0) {
+        printf("Error: failed writing timeline\n");
+        return 0;
+    }
+    return 1;
+}
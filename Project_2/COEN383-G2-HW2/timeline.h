@@ -0,0 +1,70 @@
+#ifndef TIMELINE_H
+#define TIMELINE_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include "process.h"
+
+// Run-length log of what the CPUs ran: one interval per stretch of time a
+// process held a CPU. The engine appends one interval per dispatch and
+// extends that core's last one when the same process simply runs on, so a
+// run costs O(switches) memory instead of one slot per tick.
+typedef struct {
+    int pid;        // Index into the process array of the run
+    int core;
+    double start;
+    double end;
+} Interval;
+
+typedef struct {
+    Interval *intervals;
+    int count;
+    int capacity;
+    int *last;      // last[core] = index of core's latest interval, -1 if none
+    int num_cores;  // Cores seen so far (size of last)
+} Timeline;
+
+void timeline_init(Timeline *tl);
+void timeline_free(Timeline *tl);
+void timeline_clear(Timeline *tl);
+void timeline_append(Timeline *tl, int core, int pid, double start, double end);
+
+// Timeline files hold one block per (policy, run), written as each run ends:
+//
+//   Text    "# <policy> iteration <run>" then one "name,start,end,core" line per interval.
+//   Binary  TimelineHeader followed by count TimelineRecords, host byte order.
+//
+// A path ending in ".bin" selects the binary format.
+
+#define TIMELINE_MAGIC "SCHEDTLN"
+#define TIMELINE_VERSION 1
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;   // sizeof(TimelineRecord)
+    uint64_t count;
+    char policy[16];        // NUL-padded
+    uint32_t run;           // 1-based iteration
+    uint32_t reserved;      // Zero
+} TimelineHeader;
+
+typedef struct {
+    double start;
+    double end;
+    int32_t process_id;     // Process id (trace file order), not the array index
+    int32_t core;
+} TimelineRecord;
+
+typedef struct {
+    FILE *file;
+    int binary;
+} TimelineWriter;
+
+// Returns 0 on error
+int timeline_writer_open(TimelineWriter *w, const char *path);
+int timeline_write(TimelineWriter *w, const char *policy, int run,
+                   const Timeline *tl, const Process processes[]);
+int timeline_writer_close(TimelineWriter *w);
+
+#endif
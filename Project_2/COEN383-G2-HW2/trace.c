@@ -0,0 +1,189 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <limits.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "process.h"
+#include "trace.h"
+
+// Priority is checked as a long, before any cast to int could wrap it into range
+static int valid_job(double arrival, double burst, long priority) {
+    return isfinite(arrival) && isfinite(burst) && arrival >= 0.0 && burst > 0.0 &&
+           priority >= 1 && priority <= 4;
+}
+
+static Process *load_binary_trace(const char *path, int *num_processes) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        printf("Error: cannot open trace %s\n", path);
+        return NULL;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(TraceHeader)) {
+        printf("Error: %s is too short for a binary trace\n", path);
+        close(fd);
+        return NULL;
+    }
+
+    void *map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        printf("Error: cannot map trace %s\n", path);
+        return NULL;
+    }
+    madvise(map, st.st_size, MADV_SEQUENTIAL);
+
+    const TraceHeader *header = (const TraceHeader *)map;
+    size_t available = (st.st_size - sizeof(TraceHeader)) / sizeof(TraceRecord);
+    if (header->version != TRACE_VERSION || header->record_size != sizeof(TraceRecord) ||
+        header->count > available || header->count > INT_MAX) {
+        printf("Error: %s has an unsupported or truncated trace header\n", path);
+        munmap(map, st.st_size);
+        return NULL;
+    }
+
+    int n = (int)header->count;
+    const TraceRecord *records = (const TraceRecord *)(header + 1);
+    Process *processes = (Process *)malloc(sizeof(Process) * (n > 0 ? n : 1));
+
+    for (int i = 0; i < n; i++) {
+        if (!valid_job(records[i].arrival, records[i].burst, records[i].priority)) {
+            printf("Error: %s record %d is out of range\n", path, i);
+            free(processes);
+            munmap(map, st.st_size);
+            return NULL;
+        }
+        init_process(&processes[i], i, records[i].arrival, records[i].burst, records[i].priority);
+    }
+
+    munmap(map, st.st_size);
+    *num_processes = n;
+    return processes;
+}
+
+static Process *load_csv_trace(FILE *file, const char *path, int *num_processes) {
+    int n = 0;
+    int capacity = 1024;
+    Process *processes = (Process *)malloc(sizeof(Process) * capacity);
+
+    char *line = NULL;
+    size_t line_size = 0;
+    int line_number = 0;
+
+    while (getline(&line, &line_size, file) != -1) {
+        line_number++;
+
+        char *c = line;
+        while (isspace((unsigned char)*c)) c++;
+        if (*c == '\0' || *c == '#') continue;
+
+        // A header line such as "arrival,burst,priority"
+        if (n == 0 && isalpha((unsigned char)*c)) continue;
+
+        // Every field must parse, and nothing but whitespace may follow the last
+        char *end;
+        double arrival = strtod(c, &end);
+        int parsed = (end != c);
+        c = end;
+        while (isspace((unsigned char)*c) || *c == ',') c++;
+        double burst = strtod(c, &end);
+        parsed = parsed && (end != c);
+        c = end;
+        while (isspace((unsigned char)*c) || *c == ',') c++;
+        long priority = strtol(c, &end, 10);
+        parsed = parsed && (end != c);
+        c = end;
+        while (isspace((unsigned char)*c)) c++;
+        parsed = parsed && (*c == '\0');
+
+        if (!parsed || !valid_job(arrival, burst, priority)) {
+            printf("Error: %s line %d is not a valid \"arrival,burst,priority\" job\n", path, line_number);
+            free(line);
+            free(processes);
+            return NULL;
+        }
+
+        if (n == capacity) {
+            if (capacity > INT_MAX / 2) {
+                printf("Error: %s has too many jobs\n", path);
+                free(line);
+                free(processes);
+                return NULL;
+            }
+            capacity *= 2;
+            processes = (Process *)realloc(processes, sizeof(Process) * capacity);
+        }
+        init_process(&processes[n], n, arrival, burst, (int)priority);
+        n++;
+    }
+
+    free(line);
+    *num_processes = n;
+    return processes;
+}
+
+Process *load_trace(const char *path, int *num_processes) {
+    FILE *file = fopen(path, "r");
+    if (file == NULL) {
+        printf("Error: cannot open trace %s\n", path);
+        return NULL;
+    }
+
+    char magic[8];
+    size_t got = fread(magic, 1, sizeof(magic), file);
+    Process *processes;
+
+    if (got == sizeof(magic) && memcmp(magic, TRACE_MAGIC, sizeof(magic)) == 0) {
+        fclose(file);
+        processes = load_binary_trace(path, num_processes);
+    } else {
+        rewind(file);
+        processes = load_csv_trace(file, path, num_processes);
+        fclose(file);
+    }
+
+    if (processes != NULL) {
+        sort_by_arrival(processes, *num_processes);
+    }
+    return processes;
+}
+
+int save_trace(const char *path, const Process processes[], int num_processes) {
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) {
+        printf("Error: cannot create trace %s\n", path);
+        return 0;
+    }
+
+    TraceHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, TRACE_MAGIC, sizeof(header.magic));
+    header.version = TRACE_VERSION;
+    header.record_size = sizeof(TraceRecord);
+    header.count = num_processes;
+    fwrite(&header, sizeof(header), 1, file);
+
+    // Records go out in id order so a reload assigns the same ids
+    TraceRecord *records = (TraceRecord *)malloc(sizeof(TraceRecord) * (num_processes > 0 ? num_processes : 1));
+    for (int i = 0; i < num_processes; i++) {
+        TraceRecord *r = &records[processes[i].id - 1];
+        r->arrival = processes[i].arrival_time;
+        r->burst = processes[i].service_time;
+        r->priority = processes[i].priority;
+        r->reserved = 0;
+    }
+    size_t written = fwrite(records, sizeof(TraceRecord), num_processes, file);
+    free(records);
+
+    if (fclose(file) != 0 || written != (size_t)num_processes) {
+        printf("Error: failed writing trace %s\n", path);
+        return 0;
+    }
+    return 1;
+}
@@ -0,0 +1,41 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+#include "process.h"
+
+// Workload traces: one job per record with arrival time, burst (service) time
+// and priority 1-4. Two formats are accepted:
+//
+//   CSV     "arrival,burst,priority" per line. Blank lines, '#' comments and a
+//           header line are skipped. Read line by line.
+//   Binary  TraceHeader followed by count TraceRecords, host byte order. The
+//           file is mmap'd, so multi-million job traces load without copying
+//           through stdio.
+//
+// Jobs get numeric ids in file order and are returned sorted by arrival time.
+
+#define TRACE_MAGIC "SCHEDTRC"
+#define TRACE_VERSION 1
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;   // sizeof(TraceRecord)
+    uint64_t count;
+} TraceHeader;
+
+typedef struct {
+    double arrival;
+    double burst;
+    int32_t priority;
+    int32_t reserved;       // Zero
+} TraceRecord;
+
+// Returns a malloc'd, arrival-sorted array and sets *num_processes, or NULL on error
+Process *load_trace(const char *path, int *num_processes);
+
+// Write processes as a binary trace. Returns 0 on error.
+int save_trace(const char *path, const Process processes[], int num_processes);
+
+#endif
@@ -0,0 +1,333 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+// Batch mode: thousands of seeded on-sales without any output of their own,
+// for every queue length asked for, spread over one worker thread per core.
+// Scenario k of every queue length uses seed + k, so the lengths are compared
+// on the same customers' luck, and any scenario can be replayed on its own,
+// events and all, with --replay. The report gives, per queue length and tier, the spread of
+// customers served and turned away over the scenarios and the spread of
+// response times over every customer served.
+
+#define RESPONSE_BINS 1024 // whole minutes; longer waits are counted in the last bin
+
+typedef struct
+{
+    const Venue *venue;
+    const int *queueLengths;
+    int numLengths;
+    int scenarios;     // per queue length
+    unsigned long seed;
+    int stealing;
+    void (*runScenario)(Simulation *sim);
+
+    atomic_int nextJob; // job j is scenario j % scenarios of queue length j / scenarios
+    int *served;        // [job][tier]
+    int *turned;        // [job][tier]
+} Batch;
+
+// One worker's response times, merged once every worker is done
+typedef struct
+{
+    Batch *batch;
+    long *responses;    // [length][tier][bin]
+    double *totalWait;  // [length][tier], exact sums for the means
+} BatchWorker;
+
+// Parse queue lengths such as "15", "5,10,15" or "1-20". Returns the count,
+// or 0 if the list is invalid.
+int parseQueueLengths(const char *spec, int **lengths)
+{
+    int capacity = 16;
+    int count = 0;
+    int *list = malloc(sizeof(int) * capacity);
+    const char *p = spec;
+
+    while (*p != '\0')
+    {
+        char *end;
+        long first = strtol(p, &end, 10);
+        long last = first;
+        if (end == p || first < 0)
+        {
+            free(list);
+            return 0;
+        }
+        if (*end == '-')
+        {
+            p = end + 1;
+            last = strtol(p, &end, 10);
+            if (end == p || last < first)
+            {
+                free(list);
+                return 0;
+            }
+        }
+        if (last > 1000000)
+        {
+            free(list);
+            return 0;
+        }
+
+        for (long n = first; n <= last; n++)
+        {
+            if (count == capacity)
+            {
+                capacity *= 2;
+                list = realloc(list, sizeof(int) * capacity);
+            }
+            list[count++] = (int)n;
+        }
+
+        p = end;
+        if (*p == ',')
+        {
+            p++;
+        }
+        else if (*p != '\0')
+        {
+            free(list);
+            return 0;
+        }
+    }
+
+    *lengths = list;
+    return count;
+}
+
+// Check that the results of every scenario fit in the int-indexed tables
+// runBatch keeps per scenario and tier; prints why not and returns 0 otherwise
+int validBatchSize(const Venue *venue, int numLengths, int scenarios)
+{
+    if ((long)numLengths * scenarios * venue->numTiers > INT_MAX)
+    {
+        printf("Error: %d scenarios for each of %d queue lengths are too many (at most %ld)\n",
+               scenarios, numLengths, (long)INT_MAX / ((long)numLengths * venue->numTiers));
+        return 0;
+    }
+    return 1;
+}
+
+static void *batchWorker(void *arg)
+{
+    BatchWorker *worker = (BatchWorker *)arg;
+    Batch *batch = worker->batch;
+    const Venue *venue = batch->venue;
+    int numTiers = venue->numTiers;
+    int numJobs = batch->numLengths * batch->scenarios;
+    int job;
+
+    while ((job = atomic_fetch_add(&batch->nextJob, 1)) < numJobs)
+    {
+        int length = job / batch->scenarios;
+        Simulation sim;
+
+        createSimulation(&sim, venue, batch->queueLengths[length], batch->seed + job % batch->scenarios);
+        sim.headless = 1;
+        if (batch->stealing)
+        {
+            enableStealing(&sim);
+        }
+        batch->runScenario(&sim);
+
+        int *served = &batch->served[job * numTiers];
+        int *turned = &batch->turned[job * numTiers];
+        memset(served, 0, sizeof(int) * numTiers);
+        memset(turned, 0, sizeof(int) * numTiers);
+
+        for (int s = 0; s < venue->numSellers; s++)
+        {
+            int t = (int)(sim.sellers[s].tier - venue->tiers);
+            for (int i = 0; i < sim.queueSizes[s]; i++)
+            {
+                const Customer *c = queuedCustomer(&sim, s, i);
+                if (c->gotSeat)
+                {
+                    int wait = c->startTime - c->arrivalTime;
+                    served[t]++;
+                    worker->responses[((size_t)length * numTiers + t) * RESPONSE_BINS +
+                                      MIN(wait, RESPONSE_BINS - 1)]++;
+                    worker->totalWait[length * numTiers + t] += wait;
+                }
+                else
+                {
+                    turned[t]++;
+                }
+            }
+        }
+
+        freeSimulation(&sim);
+    }
+    return NULL;
+}
+
+static int compareInts(const void *a, const void *b)
+{
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+// Nearest-rank percentile of sorted values
+static int percentile(const int *sorted, int count, int p)
+{
+    return sorted[(p * (count - 1) + 50) / 100];
+}
+
+// Percentile of the response time histogram, in minutes
+static int responsePercentile(const long *bins, long count, int p)
+{
+    long rank = (p * (count - 1) + 50) / 100;
+    for (int b = 0; b < RESPONSE_BINS; b++)
+    {
+        if (rank < bins[b])
+        {
+            return b;
+        }
+        rank -= bins[b];
+    }
+    return RESPONSE_BINS - 1;
+}
+
+// Mean, 5th, 50th and 95th percentile of one tier's counts over the scenarios of a queue length
+static void printSpread(const Batch *batch, const int *counts, int length, int tier, int *sorted)
+{
+    int numTiers = batch->venue->numTiers;
+    double total = 0;
+
+    for (int k = 0; k < batch->scenarios; k++)
+    {
+        sorted[k] = counts[(length * batch->scenarios + k) * numTiers + tier];
+        total += sorted[k];
+    }
+    qsort(sorted, batch->scenarios, sizeof(int), compareInts);
+    printf(" %8.2f %5d %5d %5d", total / batch->scenarios, percentile(sorted, batch->scenarios, 5),
+           percentile(sorted, batch->scenarios, 50), percentile(sorted, batch->scenarios, 95));
+}
+
+// Free what runBatch allocated; any pointer may be NULL
+static void freeBatch(Batch *batch, BatchWorker *workers, int numWorkers, pthread_t *tids)
+{
+    for (int w = 0; w < numWorkers; w++)
+    {
+        free(workers[w].responses);
+        free(workers[w].totalWait);
+    }
+    free(workers);
+    free(tids);
+    free(batch->served);
+    free(batch->turned);
+}
+
+// Run every scenario on numThreads workers and print the report. Returns 0,
+// after printing why, if there is not enough memory for the results.
+int runBatch(const Venue *venue, const int *queueLengths, int numLengths, int scenarios,
+              unsigned long seed, int stealing, int numThreads, void (*runScenario)(Simulation *sim))
+{
+    int numTiers = venue->numTiers;
+    size_t numJobs = (size_t)numLengths * scenarios;
+    size_t histogramSize = (size_t)numLengths * numTiers * RESPONSE_BINS;
+
+    Batch batch;
+    batch.venue = venue;
+    batch.queueLengths = queueLengths;
+    batch.numLengths = numLengths;
+    batch.scenarios = scenarios;
+    batch.seed = seed;
+    batch.stealing = stealing;
+    batch.runScenario = runScenario;
+    atomic_init(&batch.nextJob, 0);
+    batch.served = malloc(sizeof(int) * numJobs * numTiers);
+    batch.turned = malloc(sizeof(int) * numJobs * numTiers);
+
+    pthread_t *tids = malloc(sizeof(pthread_t) * numThreads);
+    BatchWorker *workers = calloc(numThreads, sizeof(BatchWorker));
+    int ok = batch.served != NULL && batch.turned != NULL && tids != NULL && workers != NULL;
+    for (int w = 0; ok && w < numThreads; w++)
+    {
+        workers[w].batch = &batch;
+        workers[w].responses = calloc(histogramSize, sizeof(long));
+        workers[w].totalWait = calloc((size_t)numLengths * numTiers, sizeof(double));
+        ok = workers[w].responses != NULL && workers[w].totalWait != NULL;
+    }
+
+    // Sums do not depend on which worker ran which scenario, so neither does the report
+    long *responses = calloc(histogramSize, sizeof(long));
+    double *totalWait = calloc((size_t)numLengths * numTiers, sizeof(double));
+    int *sorted = malloc(sizeof(int) * scenarios);
+    if (!ok || responses == NULL || totalWait == NULL || sorted == NULL)
+    {
+        printf("Error: not enough memory for %d scenarios of %d queue lengths on %d worker threads\n",
+               scenarios, numLengths, numThreads);
+        freeBatch(&batch, workers, (workers != NULL) ? numThreads : 0, tids);
+        free(responses);
+        free(totalWait);
+        free(sorted);
+        return 0;
+    }
+
+    for (int w = 0; w < numThreads; w++)
+    {
+        pthread_create(&tids[w], NULL, batchWorker, &workers[w]);
+    }
+    for (int w = 0; w < numThreads; w++)
+    {
+        pthread_join(tids[w], NULL);
+        for (size_t i = 0; i < histogramSize; i++)
+        {
+            responses[i] += workers[w].responses[i];
+        }
+        for (int i = 0; i < numLengths * numTiers; i++)
+        {
+            totalWait[i] += workers[w].totalWait[i];
+        }
+    }
+
+    printf("Batch: %d scenario%s per queue length, seeds %lu-%lu, %d worker thread%s%s\n\n", scenarios,
+           (scenarios == 1) ? "" : "s", seed, seed + scenarios - 1, numThreads, (numThreads == 1) ? "" : "s",
+           stealing ? ", work stealing" : "");
+    printf("%6s %-14s | %-26s | %-26s | Response time (minutes)\n", "", "", "Customers served",
+           "Customers turned away");
+    printf("%6s %-14s | %8s %5s %5s %5s | %8s %5s %5s %5s | %8s %5s %5s %5s\n", "N", "Tier", "mean", "p5",
+           "p50", "p95", "mean", "p5", "p50", "p95", "mean", "p50", "p95", "p99");
+
+    for (int length = 0; length < numLengths; length++)
+    {
+        for (int t = 0; t < numTiers; t++)
+        {
+            const long *bins = &responses[((size_t)length * numTiers + t) * RESPONSE_BINS];
+            long count = 0;
+            for (int b = 0; b < RESPONSE_BINS; b++)
+            {
+                count += bins[b];
+            }
+
+            printf("%6d %-14s |", queueLengths[length], venue->tiers[t].name);
+            printSpread(&batch, batch.served, length, t, sorted);
+            printf(" |");
+            printSpread(&batch, batch.turned, length, t, sorted);
+            printf(" |");
+            if (count > 0)
+            {
+                printf(" %8.2f %5d %5d %5d\n", totalWait[length * numTiers + t] / count,
+                       responsePercentile(bins, count, 50), responsePercentile(bins, count, 95),
+                       responsePercentile(bins, count, 99));
+            }
+            else
+            {
+                printf(" %8s %5s %5s %5s\n", "-", "-", "-", "-");
+            }
+        }
+    }
+
+    free(sorted);
+    free(responses);
+    free(totalWait);
+    freeBatch(&batch, workers, numThreads, tids);
+    return 1;
+}
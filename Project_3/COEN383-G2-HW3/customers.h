@@ -5,9 +5,9 @@
 
 typedef struct
 {
-    char customerID[10]; // "H001", "M205", "L304", etc.
-    char sellerType;     // 'H', 'M', or 'L'
-    int sellerID;        // 1-6 (which specific seller)
+    char customerID[16]; // "H101", "M205", "L304", etc.; "L11-05" with 10+ sellers or 100+ customers each
+    char sellerType;     // tier letter: 'H', 'M', or 'L' in the default venue
+    int sellerID;        // seller number within the tier (which specific seller)
     int customerNumber;  // sequential number for this seller (1, 2, 3...)
 
     int arrivalTime; // when they join queue (0-59 minutes)
@@ -18,6 +18,7 @@ typedef struct
     int seatRow;  // assigned seat row (0-9), or -1 if no seat
     int seatCol;  // assigned seat column (0-9), or -1 if no seat
     bool gotSeat; // true if they got a seat, false if turned away
+    bool stolen;  // served by another seller with time to spare (work stealing)
 
 } Customer;
 
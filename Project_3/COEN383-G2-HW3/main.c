@@ -5,156 +5,374 @@
 #include <unistd.h>
 #include "customers.h"
 #include "simulation_utils.c"
+#include "batch.c"
 #include "seller.h"
 
 // Main Idea: 10 ticket sellers to 100 seats concert during one hour. Each ticket seller has their own queue for buyers.
 
-// Function to assign seat based on seller type
-int assignSeat(char sellerType, char *customerID, int *seatRow, int *seatCol)
+// Function to assign seat in the order the seller's tier searches the rows.
+// Safe without the mutex: a seller first reserves one of the seats left in
+// its tier's rows, then claims the first empty seat along its row order from
+// the row bitmaps, so sellers only ever meet in the row band they are both
+// selling from. Tiers may share rows: a sale also takes the seat from every
+// other tier that sells from its row, and a reservation that finds those rows
+// full after all is given back.
+int assignSeat(Simulation *sim, const Tier *tier, int customer, int *seatRow, int *seatCol)
 {
-    if (availableSeats <= 0)
-    {
-        return 0; // No seats available
-    }
+    int t = (int)(tier - sim->venue->tiers);
 
-    int searchOrder[10];
-
-    // Define row search order for convenience based on seller type
-    if (sellerType == 'H')
-    {
-        for (int i = 0; i < 10; i++)
-            searchOrder[i] = i; // 0->9
-    }
-    else if (sellerType == 'L')
-    {
-        for (int i = 0; i < 10; i++)
-            searchOrder[i] = 9 - i; // 9->0
-    }
-    else if (sellerType == 'M')
+    // Reserve a seat; fails only once every seat in this tier's rows is sold
+    int seats = atomic_load(&sim->tierSeats[t]);
+    do
     {
-        int order[] = {4, 5, 3, 6, 2, 7, 1, 8, 0, 9};
-        for (int i = 0; i < 10; i++)
-            searchOrder[i] = order[i]; // 4,5,3,6,2,7,1,8,0,9
-    }
-    else
-    {
-        return 0;
-    }
+        if (seats <= 0)
+        {
+            return 0; // No seats available
+        }
+    } while (!atomic_compare_exchange_weak(&sim->tierSeats[t], &seats, seats - 1));
 
     // Search for empty seat based on search order
-    for (int i = 0; i < 10; i++)
+    for (int i = 0; i < tier->rowOrderLength; i++)
     {
-        int row = searchOrder[i];
-        for (int col = 0; col < 10; col++)
+        int row = tier->rowOrder[i];
+        int col = sellSeatInRow(sim, row, customer); // also records who bought it
+        if (col >= 0) // Empty seat found
         {
-            if (strcmp(seatChart[row][col], "----") == 0) // Empty seat found
+            uint64_t others = sim->venue->rowTiers[row] & ~(1ULL << t);
+            while (others != 0)
             {
-                strcpy(seatChart[row][col], customerID); // Assign customerID to seat
-                *seatRow = row;
-                *seatCol = col;
-                availableSeats--; // Decrease available seats
-                return 1;
+                atomic_fetch_sub(&sim->tierSeats[__builtin_ctzll(others)], 1);
+                others &= others - 1;
             }
+            atomic_fetch_sub(&sim->availableSeats, 1);
+
+            *seatRow = row;
+            *seatCol = col;
+            return 1;
         }
     }
 
+    atomic_fetch_add(&sim->tierSeats[t], 1); // Another tier sold the rest of our rows
     return 0; // No seat found
 }
 
+// Serve the customer at the head of a seller's queue at minute now: sell a
+// seat if one is left, otherwise turn them away. sellerFree is when the
+// seller can take the next customer. Used by both the threaded and fast modes.
+// A stolen customer still gets a seat from their own tier's rows.
+void serveCustomer(const Seller *info, Customer *customer, int now, int *sellerFree)
+{
+    Simulation *sim = info->sim;
+    const Tier *tier = customer->stolen ? customerTier(sim, customer) : info->tier;
+
+    if (now > 60 && customer->arrivalTime > 60)
+    {
+        // Customer arrived too late -> turn away
+        customer->gotSeat = 0;
+        customer->startTime = -1;
+        customer->endTime = 60;
+        return;
+    }
+
+    // Set startTime correctly
+    customer->startTime = MAX(now, *sellerFree);
+
+    logEvent(sim, EVENT_ARRIVE, customer->arrivalTime, info, customer, -1, -1);
+
+    // Now serve the customer
+    int seatRow = -1, seatCol = -1;
+    int seatAssigned = assignSeat(sim, tier, customerIndex(sim, customer), &seatRow, &seatCol);
+
+    if (seatAssigned)
+    {
+        // Seat assigned successfully
+
+        customer->seatRow = seatRow;
+        customer->seatCol = seatCol;
+        customer->gotSeat = 1;
+        customer->endTime = customer->startTime + customer->serviceTime;
+
+        *sellerFree = customer->endTime;
+
+        logEvent(sim, EVENT_ASSIGN, now, info, customer, seatRow, seatCol);
+        logEvent(sim, EVENT_COMPLETE, customer->endTime, info, customer, seatRow, seatCol);
+    }
+    else
+    {
+        // Sold out
+        customer->gotSeat = 0;
+        customer->endTime = now;
+
+        logEvent(sim, EVENT_SOLD_OUT, now, info, customer, -1, -1);
+    }
+}
+
 // Each seller serves their own queue
 void *sell(void *s_t)
 {
     // Extract seller info for convenience
     Seller *info = (Seller *)s_t;
+    Simulation *sim = info->sim;
     int myId = info->sellerID;
-    char sellerType = info->sellerType;
-    int myNumber = info->sellerNumber;
-
-    // Message buffer for printing
-    char msg[200];
 
     // Track when seller is free
     int sellerFree = 0;
 
     // Serve customers in the queue
-    while (nextCustomer[myId] < queueSizes[myId])
+    while (sim->nextCustomer[myId] < sim->queueSizes[myId])
     {
-        pthread_mutex_lock(&mutex); // Lock for synchronization
+        Customer *customer = queuedCustomer(sim, myId, sim->nextCustomer[myId]);
 
-        Customer *customer = &queues[myId][nextCustomer[myId]];
-
-        // Wait until customer arrives and seller is free, but only up to 60 min
-        while ((customer->arrivalTime > currentTime) || (currentTime < sellerFree))
+        // The mutex only guards the clock: wait until customer arrives and
+        // seller is free, but only up to 60 min
+        pthread_mutex_lock(&sim->mutex);
+        while ((customer->arrivalTime > sim->currentTime) || (sim->currentTime < sellerFree))
         {
-            if (currentTime > 60)
+            if (sim->currentTime > 60)
             {
                 break; // stop waiting if simulation ended
             }
-            pthread_cond_wait(&cond, &mutex);
+            pthread_cond_wait(&sim->cond, &sim->mutex);
         }
+        int now = sim->currentTime;
+        pthread_mutex_unlock(&sim->mutex);
+
+        // Selling needs no lock, so sellers of different tiers serve side by side
+        serveCustomer(info, customer, now, &sellerFree);
+
+        sim->nextCustomer[myId]++; // Move to next customer
+    }
+
+    return NULL;
+}
+
+// Fast mode: the same rules as sell(), on the virtual clock instead of the
+// 50ms tick. A seller only touches its own queue and claims seats atomically,
+// so nothing here takes the global mutex.
+
+// Runs once per minute, after every seller is done with it
+int endMinute(void *arg, int now)
+{
+    Simulation *sim = (Simulation *)arg;
 
-        if (currentTime > 60 && customer->arrivalTime > 60)
+    if (now >= 0 && atomic_load(&sim->availableSeats) == 0) // if sold out, end simulation early
+    {
+        logEvent(sim, EVENT_CONCERT_SOLD_OUT, now, NULL, NULL, -1, -1);
+        return 61;
+    }
+    return now + 1;
+}
+
+// One seller's work for minute now: serve whoever can start this minute;
+// once the hour is over, everyone left.
+// With --steal, a seller that is free while its own queue has nobody waiting
+// takes the latest arrival from the longest queue instead of idling. Owner and
+// thief both claim a customer before serving, so each is served exactly once.
+void serveMinute(const Seller *info, int now, int *sellerFree)
+{
+    Simulation *sim = info->sim;
+    int myId = info->sellerID;
+
+    while (sim->nextCustomer[myId] < sim->queueSizes[myId])
+    {
+        Customer *customer = queuedCustomer(sim, myId, sim->nextCustomer[myId]);
+        if (now <= 60 && (customer->arrivalTime > now || now < *sellerFree))
         {
-            // Customer arrived too late -> turn away
-            customer->gotSeat = 0;
-            customer->startTime = -1;
-            customer->endTime = 60;
-            nextCustomer[myId]++;
-            pthread_mutex_unlock(&mutex);
-            continue;
+            break; // wait for a later minute
         }
 
-        // Set startTime correctly
-        customer->startTime = MAX(currentTime, sellerFree);
+        if (!sim->stealing || claimCustomer(sim, customer, CLAIM_OWNER))
+        {
+            serveCustomer(info, customer, now, sellerFree);
+        }
+        sim->nextCustomer[myId]++; // served, or already taken by a thief
+    }
 
-        sprintf(msg, "Customer %s arrives at seller %c%d's queue",
-                customer->customerID, sellerType, myNumber);
-        printEvent(customer->arrivalTime, msg);
+    // Nothing of our own to do: help the busiest seller
+    if (sim->stealing && (now > 60 || now >= *sellerFree))
+    {
+        Customer *customer;
+        while ((customer = stealCustomer(sim, myId, now)) != NULL)
+        {
+            serveCustomer(info, customer, now, sellerFree);
+            if (now <= 60)
+            {
+                break; // busy until sellerFree
+            }
+        }
+    }
+}
 
-        // Now serve the customer
-        int seatRow = -1, seatCol = -1;
-        int seatAssigned = 0;
+void *sellFast(void *s_t)
+{
+    Seller *info = (Seller *)s_t;
+    Simulation *sim = info->sim;
+    int sellerFree = 0;
+    int now = 0;
 
-        // Assign seat safely inside mutex
-        if (availableSeats > 0)
+    while (1)
+    {
+        serveMinute(info, now, &sellerFree);
+        if (now > 60)
         {
-            seatAssigned = assignSeat(sellerType, customer->customerID, &seatRow, &seatCol);
+            break;
         }
+        now = clockAdvance(&sim->clock, endMinute, sim);
+    }
+
+    return NULL;
+}
+
+// Batch mode runs each scenario on one thread: every minute the sellers take
+// their fast-mode turns in a fixed order, so a seed always gives the same result
+void runScenario(Simulation *sim)
+{
+    int numSellers = sim->venue->numSellers;
+    int *sellerFree = calloc(numSellers, sizeof(int));
+    int now = 0;
 
-        if (seatAssigned)
+    while (1)
+    {
+        for (int i = 0; i < numSellers; i++)
+        {
+            serveMinute(&sim->sellers[i], now, &sellerFree[i]);
+        }
+        if (now > 60)
         {
-            // Seat assigned successfully
+            break;
+        }
+        now = endMinute(sim, now);
+    }
 
-            customer->seatRow = seatRow;
-            customer->seatCol = seatCol;
-            customer->gotSeat = 1;
-            customer->endTime = customer->startTime + customer->serviceTime;
+    free(sellerFree);
+}
 
-            sellerFree = customer->endTime;
+// Live mode: producers deliver buyers through each seller's ring instead of
+// sellers reading their pre-generated queue. Producer p delivers positions
+// p, p + P, p + 2P, ... of every queue, one minute ahead of the clock, so at
+// minute t a seller has every buyer who arrived by t. The sellers are still
+// fed the same buyers in the same order, so results match the fast mode.
+void *produce(void *p_t)
+{
+    Producer *producer = (Producer *)p_t;
+    Simulation *sim = producer->sim;
+    int numSellers = sim->venue->numSellers;
+    int now = sim->clock.now;
 
-            sprintf(msg, "Seller %c%d assigns seat (%d,%d) to customer %s",
-                    sellerType, myNumber, seatRow, seatCol, customer->customerID);
-            printEvent(currentTime, msg);
+    int *cursor = malloc(sizeof(int) * numSellers); // next queue position to deliver per seller
+    for (int s = 0; s < numSellers; s++)
+    {
+        cursor[s] = producer->producerID;
+    }
 
-            sprintf(msg, "Customer %s completes purchase (service: %d min)",
-                    customer->customerID, customer->serviceTime);
-            printEvent(customer->endTime, msg);
+    while (1)
+    {
+        for (int s = 0; s < numSellers; s++)
+        {
+            while (cursor[s] < sim->queueSizes[s])
+            {
+                Customer *customer = queuedCustomer(sim, s, cursor[s]);
+                if (now <= 60 && customer->arrivalTime > now + 1)
+                {
+                    break; // arrives later
+                }
+
+                if (now > 60)
+                {
+                    // Closed early because the concert sold out: never delivered, turned away
+                    int sellerFree = 0;
+                    serveCustomer(&sim->sellers[s], customer, now, &sellerFree);
+                }
+                else if (!ringPush(&sim->rings[s], customerIndex(sim, customer)))
+                {
+                    // Seller's ring is full: the buyer gives up at the door
+                    customer->gotSeat = 0;
+                    customer->endTime = customer->arrivalTime;
+                    logEvent(sim, EVENT_QUEUE_FULL, customer->arrivalTime, &sim->sellers[s], customer, -1, -1);
+                }
+                cursor[s] += sim->numProducers;
+            }
         }
-        else
+
+        if (now > 60)
+        {
+            break;
+        }
+        now = clockAdvance(&sim->clock, endMinute, sim);
+    }
+
+    free(cursor);
+    return NULL;
+}
+
+// Keep the not yet served part of a backlog in queue order: buyers from
+// different producers can come out of the ring interleaved
+static void sortBacklog(int *backlog, int length)
+{
+    for (int i = 1; i < length; i++)
+    {
+        int index = backlog[i];
+        int j = i;
+        while (j > 0 && backlog[j - 1] > index)
+        {
+            backlog[j] = backlog[j - 1];
+            j--;
+        }
+        backlog[j] = index;
+    }
+}
+
+void *sellLive(void *s_t)
+{
+    Seller *info = (Seller *)s_t;
+    Simulation *sim = info->sim;
+    MpscRing *ring = &sim->rings[info->sellerID];
+    int sellerFree = 0;
+    int now = sim->clock.now;
+
+    // Buyers taken off the ring, served from head
+    int *backlog = NULL;
+    int head = 0, length = 0, capacity = 0;
+
+    while (1)
+    {
+        int index;
+        int before = length;
+        while (ringPop(ring, &index))
+        {
+            if (length == capacity)
+            {
+                capacity = capacity ? capacity * 2 : 64;
+                backlog = realloc(backlog, sizeof(int) * capacity);
+            }
+            backlog[length++] = index;
+        }
+        if (length > before)
         {
-            // Sold out
-            customer->gotSeat = 0;
-            customer->endTime = currentTime;
+            sortBacklog(backlog + head, length - head);
+        }
+
+        // Serve whoever can start this minute; once the hour is over, everyone left
+        while (head < length)
+        {
+            Customer *customer = &sim->customers[backlog[head]];
+            if (now <= 60 && (customer->arrivalTime > now || now < sellerFree))
+            {
+                break; // wait for a later minute
+            }
 
-            sprintf(msg, "Customer %s turned away by %c%d - SOLD OUT",
-                    customer->customerID, sellerType, myNumber);
-            printEvent(currentTime, msg);
+            serveCustomer(info, customer, now, &sellerFree);
+            head++;
         }
 
-        nextCustomer[myId]++; // Move to next customer
-        pthread_mutex_unlock(&mutex);
+        if (now > 60)
+        {
+            break;
+        }
+        now = clockAdvance(&sim->clock, endMinute, sim);
     }
 
+    free(backlog);
     return NULL;
 }
 
@@ -162,124 +380,285 @@ void *sell(void *s_t)
 
 int main(int argc, char *argv[])
 {
-    // Get N from the user via command line
-    if (argc != 2)
+    // Get N (and optionally the random seed) from the user via command line.
+    // Options, anywhere on the line:
+    //   --fast runs on the virtual clock instead of real time
+    //   --live <producers> also has producer threads deliver the buyers as they
+    //       arrive (through rings of --ring <slots> per seller)
+    //   --venue <file> replaces the built-in 100-seat hall and 10 sellers
+    //   --replay runs the sellers on one thread like a --batch scenario, so
+    //       a seed always gives the same result
+    //   --steal (fast mode) lets idle sellers serve other sellers' customers
+    //   --shards adds sales and collisions per row band of the seat chart
+    //   --batch <scenarios> runs that many seeds for each N in a list such as
+    //       5,10,15 or 1-20 on --jobs <threads> (default: every core) and
+    //       prints only the summary
+    int fastMode = 0;
+    int replay = 0;
+    int stealing = 0;
+    int shardStats = 0;
+    int scenarios = 0;
+    int numThreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int numProducers = 0;
+    int ringCapacity = 1024;
+    const char *venuePath = NULL;
+    char *positional[2];
+    int numPositional = 0;
+    for (int i = 1; i < argc; i++)
     {
-        printf("Usage: %s <number_of_customers>\n", argv[0]);
-        return 1;
+        if (strcmp(argv[i], "--fast") == 0)
+        {
+            fastMode = 1;
+        }
+        else if (strcmp(argv[i], "--replay") == 0)
+        {
+            replay = 1;
+            fastMode = 1;
+        }
+        else if (strcmp(argv[i], "--steal") == 0)
+        {
+            stealing = 1;
+            fastMode = 1;
+        }
+        else if (strcmp(argv[i], "--shards") == 0)
+        {
+            shardStats = 1;
+        }
+        else if (strcmp(argv[i], "--venue") == 0 && i + 1 < argc)
+        {
+            venuePath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--live") == 0 && i + 1 < argc && atoi(argv[i + 1]) > 0)
+        {
+            numProducers = atoi(argv[++i]);
+            fastMode = 1;
+        }
+        else if (strcmp(argv[i], "--ring") == 0 && i + 1 < argc && atoi(argv[i + 1]) > 0)
+        {
+            ringCapacity = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--batch") == 0 && i + 1 < argc && atoi(argv[i + 1]) > 0)
+        {
+            scenarios = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--jobs") == 0 && i + 1 < argc && atoi(argv[i + 1]) > 0)
+        {
+            numThreads = atoi(argv[++i]);
+        }
+        else if (numPositional < 2)
+        {
+            positional[numPositional++] = argv[i];
+        }
+        else
+        {
+            numPositional = 0; // too many arguments
+            break;
+        }
     }
 
-    int N = atoi(argv[1]); // N customers for each sellers queue
-    if (N > MAX_CUSTOMERS)
+    if (numPositional == 0)
     {
-        printf("Error: N exceeds maximum allowed customers (%d)\n", MAX_CUSTOMERS);
+        printf("Usage: %s <number_of_customers> [seed] [--fast | --replay] [--live <producers> [--ring <slots>]]\n"
+               "       [--steal] [--shards] [--venue <file>]\n"
+               "       %s <N>[,<N>...|<first>-<last>] [seed] --batch <scenarios> [--jobs <threads>] [--steal]\n"
+               "       [--venue <file>]\n", argv[0], argv[0]);
         return 1;
     }
-
-    // Seed random number generator
-    srand(time(NULL));
-
-    pthread_t tids[10]; // thread ids for 10 seller threads
-
-    // Generate customers for all sellers
-    generateCustomers(queues[0], N, 'H', 1);
-    generateCustomers(queues[1], N, 'M', 1);
-    generateCustomers(queues[2], N, 'M', 2);
-    generateCustomers(queues[3], N, 'M', 3);
-    generateCustomers(queues[4], N, 'L', 1);
-    generateCustomers(queues[5], N, 'L', 2);
-    generateCustomers(queues[6], N, 'L', 3);
-    generateCustomers(queues[7], N, 'L', 4);
-    generateCustomers(queues[8], N, 'L', 5);
-    generateCustomers(queues[9], N, 'L', 6);
-
-    for (int i = 0; i < NUM_SELLERS; i++)
+    if (stealing && numProducers > 0)
     {
-        queueSizes[i] = N;   // Each seller has N customers
-        nextCustomer[i] = 0; // Start at first customer
+        printf("Error: --steal cannot be combined with --live\n");
+        return 1;
+    }
+    if (scenarios > 0 && numProducers > 0)
+    {
+        printf("Error: --batch cannot be combined with --live\n");
+        return 1;
+    }
+    if (replay && (numProducers > 0 || scenarios > 0))
+    {
+        printf("Error: --replay cannot be combined with --live or --batch\n");
+        return 1;
+    }
+    if (numThreads < 1)
+    {
+        numThreads = 1;
     }
 
-    // Initialize seating chart with empty seats "----"
-    for (int i = 0; i < 10; i++)
+    if (scenarios > 0)
     {
-        for (int j = 0; j < 10; j++)
+        int *queueLengths;
+        int numLengths = parseQueueLengths(positional[0], &queueLengths);
+        if (numLengths == 0)
         {
-            strcpy(seatChart[i][j], "----");
+            printf("Error: bad list of N %s (e.g. 15, 5,10,15 or 1-20)\n", positional[0]);
+            return 1;
         }
-    }
 
-    // Generate the sellers
-    Seller sellers[10];
+        Venue venue;
+        if (!(venuePath != NULL ? loadVenueFile(&venue, venuePath) : loadDefaultVenue(&venue)))
+        {
+            free(queueLengths);
+            return 1;
+        }
+        int ok = validBatchSize(&venue, numLengths, scenarios);
+        for (int i = 0; ok && i < numLengths; i++)
+        {
+            ok = validQueueLength(&venue, queueLengths[i]);
+        }
 
-    // Initialize seller info for identification
-    // H
-    sellers[0].sellerID = 0;
-    sellers[0].sellerType = 'H';
-    sellers[0].sellerNumber = 1;
+        unsigned long seed = (numPositional == 2) ? strtoul(positional[1], NULL, 10) : (unsigned long)time(NULL);
+        if (ok)
+        {
+            ok = runBatch(&venue, queueLengths, numLengths, scenarios, seed, stealing, numThreads, runScenario);
+        }
 
-    // M
-    for (int i = 1; i <= 3; i++)
-    {
-        sellers[i].sellerID = i;
-        sellers[i].sellerType = 'M';
-        sellers[i].sellerNumber = i; // M1, M2, M3
+        free(queueLengths);
+        freeVenue(&venue);
+        return ok ? 0 : 1;
     }
 
-    // L
-    for (int i = 4; i < 10; i++)
+    int N = atoi(positional[0]); // N customers for each sellers queue
+
+    Venue venue;
+    if (!(venuePath != NULL ? loadVenueFile(&venue, venuePath) : loadDefaultVenue(&venue)))
+    {
+        return 1;
+    }
+    if (!validQueueLength(&venue, N))
     {
-        sellers[i].sellerID = i;
-        sellers[i].sellerType = 'L';
-        sellers[i].sellerNumber = i - 3; // L1-L6
+        freeVenue(&venue);
+        return 1;
     }
 
-    // Assume 10 threads, each represents a ticket seller: H1, M1, M2, M3, L1, L2, L3, L4, L5, L6.
-    printEvent(currentTime, "Creating 10 threads representing the 10 sellers...");
-    for (int i = 0; i < 10; i++)
+    // Seed random number generator (pass the printed seed back in to replay a run)
+    unsigned long seed = (numPositional == 2) ? strtoul(positional[1], NULL, 10) : (unsigned long)time(NULL);
+    printf("Random seed: %lu\n", seed);
+
+    // Generate the sellers and their customers, and an empty seating chart
+    Simulation sim;
+    createSimulation(&sim, &venue, N, seed);
+    if (stealing)
     {
-        pthread_create(&tids[i], NULL, sell, &sellers[i]);
+        enableStealing(&sim);
     }
 
-    usleep(100000); // Allow threads to start
+    int numSellers = venue.numSellers;
+    pthread_t *tids = malloc(sizeof(pthread_t) * numSellers); // thread ids for the seller threads
 
-    // Simulate time —  60 minutes
-    for (; currentTime <= 60; currentTime++)
+    if (!replay)
     {
-        pthread_cond_broadcast(&cond); // wake up all seller threads
+        // One thread per ticket seller: H1, M1, M2, M3, L1, L2, L3, L4, L5, L6 by default.
+        char msg[100];
+        sprintf(msg, "Creating %d threads representing the %d sellers...", numSellers, numSellers);
+        printEvent(sim.currentTime, msg);
 
-        usleep(50000); // Simulate 1 minute passing (50ms)
+        // From here on, threads only queue their events and one writer thread prints them
+        startEventLog(&sim, numSellers + numProducers + 1);
+    }
+    if (replay)
+    {
+        // A batch scenario on this thread, sellers taking turns in a fixed order
+        runScenario(&sim);
+    }
+    else if (numProducers > 0)
+    {
+        // Producers and sellers drive the clock together
+        startLiveMode(&sim, numProducers, ringCapacity);
+        pthread_t *producerTids = malloc(sizeof(pthread_t) * numProducers);
+        Producer *producers = malloc(sizeof(Producer) * numProducers);
 
-        pthread_mutex_lock(&mutex);
-        int seats = availableSeats; // check available seats
-        pthread_mutex_unlock(&mutex);
+        for (int i = 0; i < numProducers; i++)
+        {
+            producers[i].producerID = i;
+            producers[i].sim = &sim;
+            pthread_create(&producerTids[i], NULL, produce, &producers[i]);
+        }
+        for (int i = 0; i < numSellers; i++)
+        {
+            pthread_create(&tids[i], NULL, sellLive, &sim.sellers[i]);
+        }
 
-        if (seats == 0) // if sold out, end simulation early
+        logEvent(&sim, EVENT_WAITING, 0, NULL, NULL, -1, -1); // printed by the writer, in order
+        for (int i = 0; i < numSellers; i++)
         {
-            char msg[100];
-            sprintf(msg, "Concert SOLD OUT at minute %d!", currentTime);
-            printEvent(currentTime, msg);
-            break;
+            pthread_join(tids[i], NULL);
+        }
+        for (int i = 0; i < numProducers; i++)
+        {
+            pthread_join(producerTids[i], NULL);
         }
+        free(producerTids);
+        free(producers);
     }
+    else if (fastMode)
+    {
+        // The sellers drive the clock themselves; just wait for them
+        for (int i = 0; i < numSellers; i++)
+        {
+            pthread_create(&tids[i], NULL, sellFast, &sim.sellers[i]);
+        }
 
-    // Signal all threads that simulation has ended
-    pthread_mutex_lock(&mutex);
-    currentTime = 61; // Set time past 60 to trigger thread exit
-    pthread_mutex_unlock(&mutex);
-    pthread_cond_broadcast(&cond);
+        logEvent(&sim, EVENT_WAITING, 0, NULL, NULL, -1, -1);
+        for (int i = 0; i < numSellers; i++)
+        {
+            pthread_join(tids[i], NULL);
+        }
+    }
+    else
+    {
+        for (int i = 0; i < numSellers; i++)
+        {
+            pthread_create(&tids[i], NULL, sell, &sim.sellers[i]);
+        }
 
-    usleep(100000); // Give threads time to exit
+        usleep(100000); // Allow threads to start
 
-    printf("Waiting for all seller threads to exit...\n");
-    for (int i = 0; i < 10; i++)
-    {
-        pthread_join(tids[i], NULL); // wait for each seller thread to finish
+        // Simulate time —  60 minutes
+        for (int minute = 0; minute <= 60; minute++)
+        {
+            pthread_mutex_lock(&sim.mutex);
+            sim.currentTime = minute;
+            pthread_mutex_unlock(&sim.mutex);
+            pthread_cond_broadcast(&sim.cond); // wake up all seller threads
+
+            usleep(50000); // Simulate 1 minute passing (50ms)
+
+            int seats = atomic_load(&sim.availableSeats); // check available seats
+
+            if (seats == 0) // if sold out, end simulation early
+            {
+                logEvent(&sim, EVENT_CONCERT_SOLD_OUT, minute, NULL, NULL, -1, -1);
+                break;
+            }
+        }
+
+        // Signal all threads that simulation has ended
+        pthread_mutex_lock(&sim.mutex);
+        sim.currentTime = 61; // Set time past 60 to trigger thread exit
+        pthread_mutex_unlock(&sim.mutex);
+        pthread_cond_broadcast(&sim.cond);
+
+        usleep(100000); // Give threads time to exit
+
+        logEvent(&sim, EVENT_WAITING, 0, NULL, NULL, -1, -1);
+        for (int i = 0; i < numSellers; i++)
+        {
+            pthread_join(tids[i], NULL); // wait for each seller thread to finish
+        }
     }
 
-    printSeatingChart();   // print final seating chart
-    calculateStatistics(); // print statistics
+    stopEventLog(&sim);        // every event is out before the results
+    printSeatingChart(&sim);   // print final seating chart
+    calculateStatistics(&sim); // print statistics
+    if (shardStats)
+    {
+        printShardStats(&sim);
+    }
 
     printf("Simulation complete.\n");
 
+    free(tids);
+    freeSimulation(&sim);
+    freeVenue(&venue);
     return 0;
 }
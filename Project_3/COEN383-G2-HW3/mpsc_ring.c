@@ -0,0 +1,97 @@
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdatomic.h>
+
+// Bounded lock-free queue of ints for many producers and one consumer. Each
+// slot carries a sequence number: a producer may fill slot pos once its
+// sequence equals pos, and the consumer may empty it once it equals pos + 1.
+// Producers only contend on the tail counter, and the consumer never writes
+// anything the producers spin on except the slot it has just emptied.
+typedef struct
+{
+    atomic_size_t sequence;
+    int value;
+} RingSlot;
+
+typedef struct
+{
+    RingSlot *slots;
+    size_t mask; // capacity - 1, capacity a power of two
+    _Alignas(64) atomic_size_t tail; // next position to fill, shared by producers
+    _Alignas(64) size_t head;        // next position to empty, consumer only
+} MpscRing;
+
+// capacity is rounded up to a power of two
+void ringInit(MpscRing *ring, size_t capacity)
+{
+    size_t size = 2;
+    while (size < capacity)
+    {
+        size *= 2;
+    }
+
+    ring->slots = malloc(sizeof(RingSlot) * size);
+    for (size_t i = 0; i < size; i++)
+    {
+        atomic_init(&ring->slots[i].sequence, i);
+    }
+    ring->mask = size - 1;
+    atomic_init(&ring->tail, 0);
+    ring->head = 0;
+}
+
+void ringFree(MpscRing *ring)
+{
+    free(ring->slots);
+    ring->slots = NULL;
+}
+
+// Any thread. Returns 0 if the ring is full.
+int ringPush(MpscRing *ring, int value)
+{
+    size_t pos = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+
+    while (1)
+    {
+        RingSlot *slot = &ring->slots[pos & ring->mask];
+        size_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        ptrdiff_t diff = (ptrdiff_t)sequence - (ptrdiff_t)pos;
+
+        if (diff == 0)
+        {
+            // Slot is free for this position; take the position if nobody beat us to it
+            if (atomic_compare_exchange_weak_explicit(&ring->tail, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed))
+            {
+                slot->value = value;
+                atomic_store_explicit(&slot->sequence, pos + 1, memory_order_release);
+                return 1;
+            }
+        }
+        else if (diff < 0)
+        {
+            return 0; // still holds a value from one lap ago
+        }
+        else
+        {
+            pos = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+        }
+    }
+}
+
+// Consumer thread only. Returns 0 if nothing is ready.
+int ringPop(MpscRing *ring, int *value)
+{
+    RingSlot *slot = &ring->slots[ring->head & ring->mask];
+    size_t sequence = atomic_load_explicit(&slot->sequence, memory_order_acquire);
+
+    if (sequence != ring->head + 1)
+    {
+        return 0; // empty, or the producer that took this slot has not written it yet
+    }
+
+    *value = slot->value;
+    atomic_store_explicit(&slot->sequence, ring->head + ring->mask + 1, memory_order_release);
+    ring->head++;
+    return 1;
+}
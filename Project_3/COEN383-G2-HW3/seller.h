@@ -6,11 +6,17 @@
 // option-3: when creating the thread, pass a struct that includes the index “i” and seller_type
 // seller thread to serve one time slice (1 minute)
 
+#include "venue.h"
+
+struct Simulation;
+
 typedef struct
 {
     int sellerID;     // 0-9 (index)
     char sellerType;  // 'H', 'M', 'L'
     int sellerNumber; // 1 for H, 1-3 for M, 1-6 for L
+    const Tier *tier; // price tier: service times and row search order
+    struct Simulation *sim;
 } Seller;
 
 #endif
\ No newline at end of file
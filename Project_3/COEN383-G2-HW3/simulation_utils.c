@@ -1,78 +1,498 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
 #include "customers.h"
+#include "seller.h"
+#include "venue.h"
+#include "rng.h"
+#include "venue.c"
+#include "virtual_clock.c"
+#include "mpsc_ring.c"
+#include "event_log.c"
 #include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
 
-// Global variables
-#define NUM_SELLERS 10
-#define MAX_CUSTOMERS 20
-Customer queues[NUM_SELLERS][MAX_CUSTOMERS]; // queues for each seller
-int queueSizes[NUM_SELLERS];                 // # of customers each seller has
-int nextCustomer[NUM_SELLERS];               // index of next customer to be served per seller
-int currentTime = 0;                         // to simulate time from 0 to 59 minutes
-char seatChart[10][10][5];                   // 2D array to represent 100 seats, each can hold customerID or "----" (5 chars)
-int availableSeats = 100;                    // total available seats left
+// The seat chart is split into bands of consecutive rows. Sales never lock a
+// band: seats are claimed with a CAS on the row bitmap. A band only keeps a
+// version that chart readers check to get a consistent copy of its rows, like
+// a seqlock, and counters showing how often sellers met in the same rows.
+#define MAX_SEAT_SHARDS 16
 
-// For synchronization
-pthread_cond_t cond = PTHREAD_COND_INITIALIZER;
-pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+typedef struct
+{
+    _Alignas(64) atomic_uint version; // bumped after every sale in the band
+    atomic_int writers;               // sales in progress in the band
+    atomic_ulong sales;
+    atomic_ulong contended;           // sales that overlapped another one in the band
+    atomic_ulong retries;             // seat CASes lost to another seller
+} SeatShard;
+
+// Everything one simulated on-sale owns, so several can run side by side
+typedef struct Simulation
+{
+    const Venue *venue;
+    Seller *sellers;          // venue->numSellers, tier by tier (H1, M1, M2, M3, L1, ...)
+    Customer *customers;      // every seller's queue, back to back
+    int *queueStart;          // index in customers of each seller's first customer
+    int *queueSizes;          // # of customers each seller has
+    atomic_int *nextCustomer; // index of next customer to be served per seller (read by thieves)
+    int currentTime;          // to simulate time from 0 to 59 minutes
+    _Atomic uint64_t *rowTaken; // bit c of row r is set once seat (r,c) is sold
+    atomic_int *seatOwner;    // buyer of each venue seat (see customerIndex), -1 if empty
+    atomic_int availableSeats; // seats not sold yet
+    atomic_int *tierSeats;    // per tier, seats left in its rows, reserved before a seat is claimed
+    SeatShard *shards;        // row bands of the seat chart
+    int numShards;
+    int shardRows;            // rows per band
+
+    // For synchronization
+    pthread_cond_t cond;
+    pthread_mutex_t mutex;
+    VirtualClock clock;       // fast and live modes
+
+    // Live mode: producer threads hand each seller its buyers as they arrive
+    int numProducers;         // 0 outside live mode
+    MpscRing *rings;          // per seller, customer indices in arrival order per producer
+
+    // Work stealing (fast mode): each customer is claimed once, by its own
+    // seller from the head of the queue or by a thief from the tail
+    int stealing;
+    atomic_uchar *claimed;    // per customer: CLAIM_NONE, CLAIM_OWNER or CLAIM_THIEF
+
+    int headless;             // batch mode: no event messages
+    int logging;              // events go through the asynchronous log
+    EventLog log;
+} Simulation;
+
+// Kinds of EventRecord
+enum
+{
+    EVENT_ARRIVE,      // customer joins their seller's queue
+    EVENT_ASSIGN,      // seller sells customer seat (row, col)
+    EVENT_COMPLETE,    // customer's purchase is done
+    EVENT_SOLD_OUT,    // seller turns customer away, no seats left
+    EVENT_QUEUE_FULL,  // live mode: customer finds seller's ring full
+    EVENT_CONCERT_SOLD_OUT,
+    EVENT_WAITING      // main thread starts joining the seller threads
+};
+
+#define CLAIM_NONE 0
+#define CLAIM_OWNER 1
+#define CLAIM_THIEF 2
+
+// A live-mode thread delivering every numProducers-th buyer of each queue
+typedef struct
+{
+    int producerID;
+    Simulation *sim;
+} Producer;
 
 // Seller thread function
 #define MAX(a, b) ((a) > (b) ? (a) : (b))
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
 
-// customer generation function for one seller
-void generateCustomers(Customer queue[], int N, char sellerType, int sellerNumber)
+// Customers are numbered by their position in sim->customers, so a seat can
+// name its buyer with an int instead of a copy of the ID string
+int customerIndex(const Simulation *sim, const Customer *customer)
 {
-    for (int i = 0; i < N; i++)
+    return (int)(customer - sim->customers);
+}
+
+// Mark every seat empty
+void clearSeats(Simulation *sim)
+{
+    for (int row = 0; row < sim->venue->numRows; row++)
     {
-        Customer *customer = &queue[i];
+        atomic_store(&sim->rowTaken[row], 0);
+    }
+    for (int seat = 0; seat < sim->venue->totalSeats; seat++)
+    {
+        atomic_store(&sim->seatOwner[seat], -1);
+    }
+    for (int s = 0; s < sim->numShards; s++)
+    {
+        SeatShard *shard = &sim->shards[s];
+        atomic_store(&shard->version, 0);
+        atomic_store(&shard->writers, 0);
+        atomic_store(&shard->sales, 0);
+        atomic_store(&shard->contended, 0);
+        atomic_store(&shard->retries, 0);
+    }
+    atomic_store(&sim->availableSeats, sim->venue->totalSeats);
+    for (int t = 0; t < sim->venue->numTiers; t++)
+    {
+        atomic_store(&sim->tierSeats[t], sim->venue->tiers[t].numSeats);
+    }
+}
 
-        // Set identity
-        customer->sellerType = sellerType;
-        customer->sellerID = sellerNumber;
-        customer->customerNumber = i + 1;
+// Claim the lowest empty seat of a row without a lock: find the first zero
+// bit and set it with a CAS, retrying if another seller changed the row first.
+// Returns the column, or -1 if the row is full.
+int claimSeatInRow(Simulation *sim, int row)
+{
+    int seats = sim->venue->rowSeats[row];
+    const uint64_t full = (seats == 64) ? ~0ULL : (1ULL << seats) - 1;
+    uint64_t taken = atomic_load(&sim->rowTaken[row]);
+
+    while (taken != full)
+    {
+        int col = __builtin_ctzll(~taken);
+        if (atomic_compare_exchange_weak(&sim->rowTaken[row], &taken, taken | (1ULL << col)))
+        {
+            return col;
+        }
+        atomic_fetch_add_explicit(&sim->shards[row / sim->shardRows].retries, 1, memory_order_relaxed);
+    }
+    return -1;
+}
 
-        // Generate customer ID string
-        sprintf(customer->customerID, "%c%d%02d", sellerType, sellerNumber, i + 1);
+// Sell the lowest empty seat of a row to customer and record the buyer. The
+// band's version moves only once both are done, so a chart reader that saw
+// the same version, and no sale in progress, before and after reading the
+// band has a consistent copy. Returns the column, or -1 if the row is full.
+int sellSeatInRow(Simulation *sim, int row, int customer)
+{
+    SeatShard *shard = &sim->shards[row / sim->shardRows];
 
-        // Random arrival time (0-59 minutes)
-        customer->arrivalTime = rand() % 60;
+    if (atomic_fetch_add(&shard->writers, 1) > 0)
+    {
+        atomic_fetch_add_explicit(&shard->contended, 1, memory_order_relaxed);
+    }
 
-        // Random service time based on seller type
-        if (sellerType == 'H')
+    int col = claimSeatInRow(sim, row);
+    if (col >= 0)
+    {
+        atomic_store_explicit(&sim->seatOwner[sim->venue->rowFirstSeat[row] + col], customer,
+                              memory_order_release);
+        atomic_fetch_add(&shard->version, 1);
+        atomic_fetch_add_explicit(&shard->sales, 1, memory_order_relaxed);
+    }
+
+    atomic_fetch_sub(&shard->writers, 1);
+    return col;
+}
+
+// Copy the buyers of rows first..last (one band) into owners, retrying while
+// a sale in the band is in progress or finished during the copy
+static void readShard(Simulation *sim, int first, int last, int *owners)
+{
+    SeatShard *shard = &sim->shards[first / sim->shardRows];
+    int from = sim->venue->rowFirstSeat[first];
+    int to = sim->venue->rowFirstSeat[last] + sim->venue->rowSeats[last];
+
+    while (1)
+    {
+        unsigned version = atomic_load(&shard->version);
+        if (atomic_load(&shard->writers) == 0)
         {
-            customer->serviceTime = 1 + (rand() % 2); // 1 or 2
+            for (int seat = from; seat < to; seat++)
+            {
+                owners[seat - from] = atomic_load_explicit(&sim->seatOwner[seat], memory_order_relaxed);
+            }
+            atomic_thread_fence(memory_order_acquire);
+            if (atomic_load(&shard->writers) == 0 && atomic_load(&shard->version) == version)
+            {
+                return;
+            }
         }
-        else if (sellerType == 'M')
+        sched_yield();
+    }
+}
+
+// Arrival order; customers arriving together keep their generation order
+static int compareArrival(const void *a, const void *b)
+{
+    const Customer *x = (const Customer *)a;
+    const Customer *y = (const Customer *)b;
+    if (x->arrivalTime != y->arrivalTime)
+    {
+        return x->arrivalTime - y->arrivalTime;
+    }
+    return x->customerNumber - y->customerNumber;
+}
+
+// customer generation function for one seller, drawing from that seller's own random stream
+void generateCustomers(Customer queue[], int N, const Seller *seller, Rng *rng)
+{
+    const Tier *tier = seller->tier;
+
+    for (int i = 0; i < N; i++)
+    {
+        Customer *customer = &queue[i];
+
+        // Set identity
+        customer->sellerType = seller->sellerType;
+        customer->sellerID = seller->sellerNumber;
+        customer->customerNumber = i + 1;
+
+        // Generate customer ID string; with 10+ sellers in the tier or 100+
+        // customers each, a dash keeps L1 customer 101 and L11 customer 1 apart
+        if (tier->numSellers >= 10 || N >= 100)
         {
-            customer->serviceTime = 2 + (rand() % 3); // 2, 3, or 4
+            snprintf(customer->customerID, sizeof(customer->customerID), "%c%d-%02d",
+                     seller->sellerType, seller->sellerNumber, i + 1);
         }
         else
-        {                                             // 'L'
-            customer->serviceTime = 4 + (rand() % 4); // 4, 5, 6, or 7
+        {
+            snprintf(customer->customerID, sizeof(customer->customerID), "%c%d%02d",
+                     seller->sellerType, seller->sellerNumber, i + 1);
         }
 
+        // Random arrival time (0-59 minutes)
+        customer->arrivalTime = rng_below(rng, 60);
+
+        // Random service time in the tier's range (H: 1-2, M: 2-4, L: 4-7 by default)
+        customer->serviceTime = tier->minService + rng_below(rng, tier->maxService - tier->minService + 1);
+
         // Initialize other fields
         customer->startTime = -1;
         customer->endTime = -1;
         customer->seatRow = -1;
         customer->seatCol = -1;
         customer->gotSeat = 0; // false
+        customer->stolen = 0;
     }
 
-    // Bubblesort customers by arrival time
-    for (int i = 0; i < N - 1; i++)
+    // Sort customers by arrival time
+    qsort(queue, N, sizeof(Customer), compareArrival);
+}
+
+#define MAX_CUSTOMERS 1000           // per seller
+#define MAX_TOTAL_CUSTOMERS 2000000  // over all sellers of a venue
+
+// Check that a queue length is one createSimulation can take for venue;
+// prints why not and returns 0 otherwise
+int validQueueLength(const Venue *venue, int N)
+{
+    if (N < 0 || N > MAX_CUSTOMERS)
     {
-        for (int j = 0; j < N - i - 1; j++)
+        printf("Error: N must be between 0 and %d\n", MAX_CUSTOMERS);
+        return 0;
+    }
+    if ((long)N * venue->numSellers > MAX_TOTAL_CUSTOMERS)
+    {
+        printf("Error: %d customers for each of %d sellers is more than %d in all\n",
+               N, venue->numSellers, MAX_TOTAL_CUSTOMERS);
+        return 0;
+    }
+    return 1;
+}
+
+// Set up a simulation of venue with N customers per seller; seller i draws
+// its customers from stream i of seed
+void createSimulation(Simulation *sim, const Venue *venue, int N, unsigned long seed)
+{
+    int numSellers = venue->numSellers;
+
+    sim->venue = venue;
+    sim->sellers = malloc(sizeof(Seller) * numSellers);
+    sim->customers = malloc(sizeof(Customer) * ((size_t)numSellers * N + 1));
+    sim->queueStart = malloc(sizeof(int) * numSellers);
+    sim->queueSizes = malloc(sizeof(int) * numSellers);
+    sim->nextCustomer = malloc(sizeof(atomic_int) * numSellers);
+    sim->currentTime = 0;
+    sim->rowTaken = malloc(sizeof(*sim->rowTaken) * venue->numRows);
+    sim->seatOwner = malloc(sizeof(atomic_int) * venue->totalSeats);
+    sim->tierSeats = malloc(sizeof(atomic_int) * venue->numTiers);
+    sim->shardRows = (venue->numRows + MAX_SEAT_SHARDS - 1) / MAX_SEAT_SHARDS;
+    sim->numShards = (venue->numRows + sim->shardRows - 1) / sim->shardRows;
+    sim->shards = aligned_alloc(_Alignof(SeatShard), sizeof(SeatShard) * sim->numShards);
+    pthread_cond_init(&sim->cond, NULL);
+    pthread_mutex_init(&sim->mutex, NULL);
+    clockInit(&sim->clock, numSellers);
+    sim->numProducers = 0;
+    sim->rings = NULL;
+    sim->stealing = 0;
+    sim->claimed = NULL;
+    sim->headless = 0;
+    sim->logging = 0;
+    clearSeats(sim);
+
+    // Sellers are numbered within their tier: H1, M1, M2, M3, L1, ..., L6
+    int id = 0;
+    for (int t = 0; t < venue->numTiers; t++)
+    {
+        for (int n = 1; n <= venue->tiers[t].numSellers; n++, id++)
         {
-            if (queue[j].arrivalTime > queue[j + 1].arrivalTime)
-            {
-                Customer temp = queue[j];
-                queue[j] = queue[j + 1];
-                queue[j + 1] = temp;
-            }
+            Seller *seller = &sim->sellers[id];
+            seller->sellerID = id;
+            seller->sellerType = venue->tiers[t].letter;
+            seller->sellerNumber = n;
+            seller->tier = &venue->tiers[t];
+            seller->sim = sim;
         }
     }
+
+    // Generate customers for all sellers, each seller from its own stream of the seed
+    for (int i = 0; i < numSellers; i++)
+    {
+        Rng rng;
+        rng_stream(&rng, seed, i);
+
+        sim->queueStart[i] = i * N;
+        sim->queueSizes[i] = N;   // Each seller has N customers
+        atomic_init(&sim->nextCustomer[i], 0); // Start at first customer
+        generateCustomers(&sim->customers[i * N], N, &sim->sellers[i], &rng);
+    }
+}
+
+// Switch sim to live arrivals: numProducers producer threads share the clock
+// with the sellers, and each seller gets a ring of ringCapacity slots. The
+// clock starts a minute early so minute 0's buyers are delivered before it.
+void startLiveMode(Simulation *sim, int numProducers, size_t ringCapacity)
+{
+    int numSellers = sim->venue->numSellers;
+
+    sim->numProducers = numProducers;
+    sim->rings = malloc(sizeof(MpscRing) * numSellers);
+    for (int i = 0; i < numSellers; i++)
+    {
+        ringInit(&sim->rings[i], ringCapacity);
+    }
+
+    clockDestroy(&sim->clock);
+    clockInit(&sim->clock, numSellers + numProducers);
+    sim->clock.now = -1;
+}
+
+void freeSimulation(Simulation *sim)
+{
+    free(sim->claimed);
+    if (sim->rings != NULL)
+    {
+        for (int i = 0; i < sim->venue->numSellers; i++)
+        {
+            ringFree(&sim->rings[i]);
+        }
+        free(sim->rings);
+    }
+    free(sim->sellers);
+    free(sim->customers);
+    free(sim->queueStart);
+    free(sim->queueSizes);
+    free(sim->nextCustomer);
+    free(sim->rowTaken);
+    free(sim->seatOwner);
+    free(sim->tierSeats);
+    free(sim->shards);
+    pthread_cond_destroy(&sim->cond);
+    pthread_mutex_destroy(&sim->mutex);
+    clockDestroy(&sim->clock);
+}
+
+// Customer at position i of seller's queue
+Customer *queuedCustomer(Simulation *sim, int seller, int i)
+{
+    return &sim->customers[sim->queueStart[seller] + i];
+}
+
+// Let idle sellers take waiting customers from other sellers' queues
+void enableStealing(Simulation *sim)
+{
+    size_t numCustomers = (size_t)sim->queueStart[sim->venue->numSellers - 1] +
+                          sim->queueSizes[sim->venue->numSellers - 1];
+
+    sim->stealing = 1;
+    sim->claimed = malloc(numCustomers + 1);
+    for (size_t i = 0; i < numCustomers; i++)
+    {
+        atomic_init(&sim->claimed[i], CLAIM_NONE);
+    }
+}
+
+// Claim a customer for serving; fails if someone else already has
+int claimCustomer(Simulation *sim, const Customer *customer, int claimant)
+{
+    unsigned char expected = CLAIM_NONE;
+    return atomic_compare_exchange_strong(&sim->claimed[customerIndex(sim, customer)], &expected, claimant);
+}
+
+// Number of customers in seller's queue who have arrived by minute now
+// (everyone once the hour is over)
+static int arrivedBy(Simulation *sim, int seller, int now)
+{
+    int low = 0, high = sim->queueSizes[seller];
+    if (now > 60)
+    {
+        return high;
+    }
+    while (low < high)
+    {
+        int mid = (low + high) / 2;
+        if (queuedCustomer(sim, seller, mid)->arrivalTime <= now)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+// For an idle thief: the latest arrival still waiting in the queue with the
+// most customers waiting, claimed for the thief. NULL if nobody is waiting.
+Customer *stealCustomer(Simulation *sim, int thief, int now)
+{
+    int victim = -1;
+    int victimNext = 0;
+    int victimArrived = 0;
+    int mostWaiting = 0;
+
+    for (int s = 0; s < sim->venue->numSellers; s++)
+    {
+        if (s == thief)
+        {
+            continue;
+        }
+        int next = atomic_load(&sim->nextCustomer[s]);
+        int arrived = arrivedBy(sim, s, now);
+        if (arrived - next > mostWaiting)
+        {
+            victim = s;
+            victimNext = next;
+            victimArrived = arrived;
+            mostWaiting = arrived - next;
+        }
+    }
+    if (victim == -1)
+    {
+        return NULL;
+    }
+
+    // Walk down from the tail past customers other thieves took; the owner
+    // claims from the head, so everything below its first claim is taken
+    for (int i = victimArrived - 1; i >= victimNext; i--)
+    {
+        Customer *customer = queuedCustomer(sim, victim, i);
+        unsigned char claim = atomic_load(&sim->claimed[customerIndex(sim, customer)]);
+        if (claim == CLAIM_OWNER)
+        {
+            break;
+        }
+        if (claim == CLAIM_NONE && claimCustomer(sim, customer, CLAIM_THIEF))
+        {
+            customer->stolen = 1;
+            return customer;
+        }
+    }
+    return NULL;
+}
+
+// Tier a customer buys from: their own seller's, even if another seller serves them
+const Tier *customerTier(const Simulation *sim, const Customer *customer)
+{
+    for (int t = 0; t < sim->venue->numTiers; t++)
+    {
+        if (sim->venue->tiers[t].letter == customer->sellerType)
+        {
+            return &sim->venue->tiers[t];
+        }
+    }
+    return NULL;
 }
 
 // For debugging — prints all customers for one seller
@@ -105,159 +525,310 @@ void printEvent(int time, char *message)
     printf("[Time %02d:%02d] %s\n", hours, minutes, message);
 }
 
-// Print the seating chart
-void printSeatingChart()
+// Print one logged event (on the log's writer thread)
+void writeEvent(void *arg, const EventRecord *event)
 {
-    pthread_mutex_lock(&mutex);
-    printf("\n========== SEATING CHART ==========\n");
-    printf("    ");
+    Simulation *sim = (Simulation *)arg;
+    const Seller *seller = (event->seller >= 0) ? &sim->sellers[event->seller] : NULL;
+    const Customer *customer = (event->customer >= 0) ? &sim->customers[event->customer] : NULL;
+    char msg[200];
 
-    // Print column headers (0-9)
-    for (int col = 0; col < 10; col++)
+    switch (event->kind)
+    {
+    case EVENT_ARRIVE:
+        sprintf(msg, "Customer %s arrives at seller %c%d's queue",
+                customer->customerID, customer->sellerType, customer->sellerID);
+        break;
+    case EVENT_ASSIGN:
     {
-        printf("Col%d ", col);
+        int length = sprintf(msg, "Seller %c%d assigns seat (%d,%d) to customer %s",
+                             seller->sellerType, seller->sellerNumber, event->row, event->col,
+                             customer->customerID);
+        if (customer->stolen)
+        {
+            sprintf(msg + length, " (stolen from %c%d)", customer->sellerType, customer->sellerID);
+        }
+        break;
     }
-    printf("\n");
+    case EVENT_COMPLETE:
+        sprintf(msg, "Customer %s completes purchase (service: %d min)",
+                customer->customerID, customer->serviceTime);
+        break;
+    case EVENT_SOLD_OUT:
+        sprintf(msg, "Customer %s turned away by %c%d - SOLD OUT",
+                customer->customerID, seller->sellerType, seller->sellerNumber);
+        break;
+    case EVENT_QUEUE_FULL:
+        sprintf(msg, "Customer %s turned away by %c%d - QUEUE FULL",
+                customer->customerID, seller->sellerType, seller->sellerNumber);
+        break;
+    case EVENT_WAITING:
+        printf("Waiting for all seller threads to exit...\n"); // no timestamp, as before the log
+        return;
+    default:
+        sprintf(msg, "Concert SOLD OUT at minute %d!", event->time);
+        break;
+    }
+    printEvent(event->time, msg);
+}
 
-    // Print separator line
-    printf("    ");
-    for (int col = 0; col < 10; col++)
+// Record an event: into the asynchronous log once it is started, printed
+// right away before that, and not at all in batch mode
+void logEvent(Simulation *sim, int kind, int time, const Seller *seller, const Customer *customer,
+              int row, int col)
+{
+    if (sim->headless)
     {
-        printf("---- ");
+        return;
     }
-    printf("\n");
 
-    // Print each row
-    for (int row = 0; row < 10; row++)
+    EventRecord event;
+    event.time = time;
+    event.kind = kind;
+    event.seller = (seller != NULL) ? seller->sellerID : -1;
+    event.customer = (customer != NULL) ? customerIndex(sim, customer) : -1;
+    event.row = row;
+    event.col = col;
+
+    if (sim->logging)
     {
-        printf("R%d: ", row); // Row label
+        eventLogPush(&sim->log, &event);
+    }
+    else
+    {
+        writeEvent(sim, &event);
+    }
+}
+
+// Hand event printing to a writer thread; maxThreads is every thread that may log
+void startEventLog(Simulation *sim, int maxThreads)
+{
+    eventLogStart(&sim->log, maxThreads, 1024, writeEvent, sim);
+    sim->logging = 1;
+}
+
+// After every logging thread has finished: print the rest of the events
+void stopEventLog(Simulation *sim)
+{
+    if (sim->logging)
+    {
+        eventLogStop(&sim->log);
+        sim->logging = 0;
+    }
+}
+
+// Venues bigger than this get a per-section summary instead of every seat
+#define CHART_MAX_SEATS 2000
+
+// Print the seating chart. Takes no lock, so it may run while sellers are
+// still selling: each band is copied consistently first, then printed.
+void printSeatingChart(Simulation *sim)
+{
+    const Venue *venue = sim->venue;
+
+    printf("\n========== SEATING CHART ==========\n");
 
-        for (int col = 0; col < 10; col++)
+    if (venue->totalSeats > CHART_MAX_SEATS)
+    {
+        for (int s = 0; s < venue->numSections; s++)
         {
-            printf("%-4s ", seatChart[row][col]); // Print customer ID or "----"
+            const Section *section = &venue->sections[s];
+            int sold = 0;
+            for (int r = section->firstRow; r < section->firstRow + section->numRows; r++)
+            {
+                sold += __builtin_popcountll(atomic_load(&sim->rowTaken[r]));
+            }
+            printf("%-*s rows %d-%d: %d / %d sold\n", MAX_NAME, section->name, section->firstRow,
+                   section->firstRow + section->numRows - 1, sold, section->numRows * section->seatsPerRow);
         }
-        printf("\n");
     }
+    else
+    {
+        int *owners = malloc(sizeof(int) * venue->totalSeats);
+        for (int first = 0; first < venue->numRows; first += sim->shardRows)
+        {
+            int last = MIN(first + sim->shardRows, venue->numRows) - 1;
+            readShard(sim, first, last, &owners[venue->rowFirstSeat[first]]);
+        }
 
-    printf("===================================\n");
-    printf("Available seats: %d / 100\n\n", availableSeats);
-    pthread_mutex_unlock(&mutex);
-}
+        // Columns are as wide as the widest column header or buyer's ID, and
+        // row labels as wide as the last row's
+        int width = snprintf(NULL, 0, "Col%d", venue->maxRowSeats - 1);
+        for (int seat = 0; seat < venue->totalSeats; seat++)
+        {
+            if (owners[seat] >= 0)
+            {
+                width = MAX(width, (int)strlen(sim->customers[owners[seat]].customerID));
+            }
+        }
+        int labelWidth = snprintf(NULL, 0, "R%d: ", venue->numRows - 1);
+        char empty[sizeof(((Customer *)0)->customerID) + 8];
+        memset(empty, '-', width);
+        empty[width] = '\0';
 
-// Function to calculate and print statistics
-void calculateStatistics()
-{
-    int H_turned = 0;
-    int M_turned = 0;
-    int L_turned = 0;
-    int H_served = 0;
-    int M_served = 0;
-    int L_served = 0;
-    double h_total_rt = 0;
-    double m_total_rt = 0;
-    double l_total_rt = 0;
-    double h_total_tt = 0;
-    double m_total_tt = 0;
-    double l_total_tt = 0;
-
-    // Iterate through all sellers and their queues
-    for (int seller = 0; seller < NUM_SELLERS; seller++)
-    {
-        char sellerType;
-        if (seller == 0)
+        printf("%*s", labelWidth, "");
+
+        // Print column headers
+        for (int col = 0; col < venue->maxRowSeats; col++)
         {
-            sellerType = 'H';
+            char header[16];
+            snprintf(header, sizeof(header), "Col%d", col);
+            printf("%-*s ", width, header);
         }
-        else if (seller >= 1 && seller < 4)
+        printf("\n");
+
+        // Print separator line
+        printf("%*s", labelWidth, "");
+        for (int col = 0; col < venue->maxRowSeats; col++)
         {
-            sellerType = 'M';
+            printf("%s ", empty);
         }
-        else
+        printf("\n");
+
+        // Print each row
+        for (int row = 0; row < venue->numRows; row++)
         {
-            sellerType = 'L';
+            char label[16];
+            snprintf(label, sizeof(label), "R%d: ", row);
+            printf("%-*s", labelWidth, label); // Row label
+
+            for (int col = 0; col < venue->rowSeats[row]; col++)
+            {
+                int owner = owners[venue->rowFirstSeat[row] + col];
+                const char *id = (owner < 0) ? empty : sim->customers[owner].customerID;
+                printf("%-*s ", width, id); // Print customer ID or dashes
+            }
+            printf("\n");
         }
+        free(owners);
+    }
+
+    printf("===================================\n");
+    printf("Available seats: %d / %d\n\n", atomic_load(&sim->availableSeats), venue->totalSeats);
+}
 
-        // Process each customer in the seller's queue
-        for (int i = 0; i < queueSizes[seller]; i++)
+// Sales and collisions per row band of the seat chart
+void printShardStats(Simulation *sim)
+{
+    printf("========== SEAT SHARDS ==========\n");
+    printf("%-12s %8s %10s %8s\n", "Rows", "Sales", "Contended", "Retries");
+    for (int s = 0; s < sim->numShards; s++)
+    {
+        const SeatShard *shard = &sim->shards[s];
+        int first = s * sim->shardRows;
+        int last = MIN(first + sim->shardRows, sim->venue->numRows) - 1;
+        char rows[32];
+
+        snprintf(rows, sizeof(rows), (first == last) ? "%d" : "%d-%d", first, last);
+        printf("%-12s %8lu %10lu %8lu\n", rows, atomic_load(&shard->sales),
+               atomic_load(&shard->contended), atomic_load(&shard->retries));
+    }
+    printf("=================================\n\n");
+}
+
+// Heading of a tier's statistics: "High-Price Seller (H)", "Medium-Price
+// Sellers (M1, M2, M3)" or, for longer lists, "Low-Price Sellers (L1-L6)"
+static void printTierHeading(const Tier *tier)
+{
+    if (tier->numSellers == 1)
+    {
+        printf("%s Seller (%c):\n", tier->name, tier->letter);
+    }
+    else if (tier->numSellers <= 3)
+    {
+        printf("%s Sellers (", tier->name);
+        for (int n = 1; n <= tier->numSellers; n++)
         {
-            Customer *c = &queues[seller][i];
-            if (c->gotSeat == 1)
+            printf("%c%d%s", tier->letter, n, (n < tier->numSellers) ? ", " : "):\n");
+        }
+    }
+    else
+    {
+        printf("%s Sellers (%c1-%c%d):\n", tier->name, tier->letter, tier->letter, tier->numSellers);
+    }
+}
+
+// Function to calculate and print statistics
+void calculateStatistics(Simulation *sim)
+{
+    const Venue *venue = sim->venue;
+    int totalServed = 0;
+    int totalTurned = 0;
+    int totalStolen = 0;
+    double totalResponse = 0;
+
+    for (int t = 0; t < venue->numTiers; t++)
+    {
+        const Tier *tier = &venue->tiers[t];
+        int served = 0;
+        int turned = 0;
+        int stolen = 0;
+        double totalRt = 0;
+        double totalTt = 0;
+
+        // Process each customer in the queues of this tier's sellers
+        for (int seller = 0; seller < venue->numSellers; seller++)
+        {
+            if (sim->sellers[seller].tier != tier)
             {
-                int each_customer_rt = c->startTime - c->arrivalTime;
-                int each_customer_tt = c->endTime - c->arrivalTime;
-                if (sellerType == 'H')
-                {
-                    h_total_rt += each_customer_rt;
-                    h_total_tt += each_customer_tt;
-                    H_served++;
-                }
-                else if (sellerType == 'M')
+                continue;
+            }
+
+            for (int i = 0; i < sim->queueSizes[seller]; i++)
+            {
+                Customer *c = queuedCustomer(sim, seller, i);
+                if (c->gotSeat == 1)
                 {
-                    m_total_rt += each_customer_rt;
-                    m_total_tt += each_customer_tt;
-                    M_served++;
+                    totalRt += c->startTime - c->arrivalTime;
+                    totalTt += c->endTime - c->arrivalTime;
+                    served++;
+                    stolen += c->stolen;
                 }
                 else
                 {
-                    l_total_rt += each_customer_rt;
-                    l_total_tt += each_customer_tt;
-                    L_served++;
+                    turned++;
                 }
             }
+        }
+
+        printTierHeading(tier);
+        printf("  Customers served: %d\n", served);
+        printf("  Customers turned away: %d\n", turned);
+        if (sim->stealing)
+        {
+            printf("  Served by other sellers: %d\n", stolen);
+        }
+        if (served > 0)
+        {
+            printf("  Average response time: %.2f minutes\n", totalRt / served);
+            printf("  Average turnaround time: %.2f minutes\n", totalTt / served);
+            if (tier->numSellers == 1)
+            {
+                printf("  Throughput: %.2f customers/hour\n", (double)served); /// 60.0
+            }
             else
             {
-                if (sellerType == 'H')
-                {
-                    H_turned++;
-                }
-                else if (sellerType == 'M')
-                {
-                    M_turned++;
-                }
-                else
-                {
-                    L_turned++;
-                }
+                printf("  Throughput per seller: %.2f customers/hour\n", (double)served / tier->numSellers); /// 60.0
             }
         }
-    }
-    printf("High-Price Seller (H):\n");
-    printf("  Customers served: %d\n", H_served);
-    printf("  Customers turned away: %d\n", H_turned);
-    if (H_served > 0)
-    {
-        printf("  Average response time: %.2f minutes\n", h_total_rt / H_served);
-        printf("  Average turnaround time: %.2f minutes\n", h_total_tt / H_served);
-        printf("  Throughput: %.2f customers/hour\n", (double)H_served); /// 60.0
-    }
-    printf("\n");
+        printf("\n");
 
-    // Medium-price sellers
-    printf("Medium-Price Sellers (M1, M2, M3):\n");
-    printf("  Customers served: %d\n", M_served);
-    printf("  Customers turned away: %d\n", M_turned);
-    if (M_served > 0)
-    {
-        printf("  Average response time: %.2f minutes\n", m_total_rt / M_served);
-        printf("  Average turnaround time: %.2f minutes\n", m_total_tt / M_served);
-        printf("  Throughput per seller: %.2f customers/hour\n", (double)M_served / 3.0); /// 60.0
+        totalServed += served;
+        totalTurned += turned;
+        totalStolen += stolen;
+        totalResponse += totalRt;
     }
-    printf("\n");
 
-    // Low-price sellers
-    printf("Low-Price Sellers (L1-L6):\n");
-    printf("  Customers served: %d\n", L_served);
-    printf("  Customers turned away: %d\n", L_turned);
-    if (L_served > 0)
+    printf("Total served: %d\n", totalServed);
+    printf("Total turned away: %d\n", totalTurned);
+    if (sim->stealing)
     {
-        printf("  Average response time: %.2f minutes\n", l_total_rt / L_served);
-        printf("  Average turnaround time: %.2f minutes\n", l_total_tt / L_served);
-        // per hour
-        printf("  Throughput per seller: %.2f customers/hour\n", (double)L_served / 6.0); /// 60.0
+        // Compare with a --fast run of the same seed to see what stealing bought
+        printf("Total served by other sellers: %d\n", totalStolen);
+        if (totalServed > 0)
+        {
+            printf("Average response time: %.2f minutes\n", totalResponse / totalServed);
+        }
     }
-    printf("\n");
-
-    printf("Total served: %d\n", H_served + M_served + L_served);
-    printf("Total turned away: %d\n", H_turned + M_turned + L_turned);
     printf("==========================================\n\n");
 }
@@ -0,0 +1,60 @@
+#!/bin/sh
+# Sell-out regression test: on a venue whose tiers each sell only their own
+# rows, every mode must sell every seat of every tier. A seller whose rows are
+# full must not make another tier look sold out, or end the concert early.
+# Build and run from COEN383-G2-HW3:
+#
+#   gcc -pthread main.c -o ticketSimulation
+#   sh tests/sellout.sh [runs per mode]
+
+BIN=./ticketSimulation
+VENUE=tests/split_tiers.venue
+RUNS=${1:-50}
+EXPECTED="4 12 24"   # seats of tiers H, M and L
+
+failed=0
+
+# check <mode> <args...>: one run must sell out every tier
+check() {
+    mode=$1
+    shift
+    output=$("$BIN" "$@" --venue "$VENUE")
+    served=$(echo "$output" | awk '/Customers served:/ { printf "%s%s", sep, $3; sep = " " }')
+    if [ "$served" != "$EXPECTED" ] || ! echo "$output" | grep -q "^Available seats: 0 / 40"; then
+        echo "FAIL $mode ($*): served $served, expected $EXPECTED"
+        failed=$((failed + 1))
+    fi
+}
+
+for mode in fast live steal; do
+    case $mode in
+        fast) options="--fast" ;;
+        live) options="--live 2" ;;
+        steal) options="--steal" ;;
+    esac
+    for seed in $(seq 1 "$RUNS"); do
+        check "$mode" 10 "$seed" $options
+    done
+    echo "done $mode, $RUNS runs"
+done
+
+# The threaded mode runs in real time (about 3 seconds), so only a few runs
+for seed in 1 2 3; do
+    check threaded 10 "$seed"
+done
+echo "done threaded, 3 runs"
+
+# Batch mode: every scenario sells out, so p5 and p95 of customers served
+# are both the tier's seats
+batch=$($BIN 10 1 --batch "$RUNS" --venue "$VENUE" | awk '$1 == "10" && $5 == $7 { printf "%s%s", sep, $5; sep = " " }')
+if [ "$batch" != "$EXPECTED" ]; then
+    echo "FAIL batch: served $batch in every scenario, expected $EXPECTED"
+    failed=$((failed + 1))
+fi
+echo "done batch, $RUNS scenarios"
+
+if [ "$failed" -gt 0 ]; then
+    echo "$failed runs failed"
+    exit 1
+fi
+echo "all runs sold out"
@@ -0,0 +1,365 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include "venue.h"
+
+// Venue file format, one item per line ('#' starts a comment):
+//
+//   section <name> <rows> <seats per row> [count]
+//       A block of rows, 1-64 seats wide. With a count, that many identical
+//       sections named <name>1, <name>2, ... Rows are numbered front to back
+//       in the order sections are listed.
+//   tier <letter> <name> <sellers> <min>-<max> <rows>
+//       A price tier with its number of sellers, service time range in
+//       minutes and row search order: front (first row to last), back (last
+//       to first), middle (middle row outwards) or a list such as 0-4,9,8.
+//
+// The built-in venue is the assignment's 100-seat hall:
+static const char *defaultVenue =
+    "section Hall 10 10\n"
+    "tier H High-Price 1 1-2 front\n"
+    "tier M Medium-Price 3 2-4 middle\n"
+    "tier L Low-Price 6 4-7 back\n";
+
+#define MAX_TOKENS 8
+
+// Split line into whitespace-separated tokens, dropping any comment
+static int tokenize(char *line, char *tokens[])
+{
+    char *comment = strchr(line, '#');
+    if (comment != NULL)
+    {
+        *comment = '\0';
+    }
+
+    int count = 0;
+    for (char *token = strtok(line, " \t\r\n"); token != NULL; token = strtok(NULL, " \t\r\n"))
+    {
+        if (count == MAX_TOKENS)
+        {
+            return -1;
+        }
+        tokens[count++] = token;
+    }
+    return count;
+}
+
+// Parse a positive int that must make up the whole token
+static int parseCount(const char *token, int *value)
+{
+    char *end;
+    long parsed = strtol(token, &end, 10);
+    if (*end != '\0' || parsed < 0 || parsed > 1000000000)
+    {
+        return 0;
+    }
+    *value = (int)parsed;
+    return 1;
+}
+
+// Turn a row search order into row numbers
+static int parseRowOrder(const char *spec, int numRows, int **order, int *length)
+{
+    int *rows = malloc(sizeof(int) * ((size_t)numRows * 2 + 1)); // numRows <= MAX_VENUE_ROWS
+    int count = 0;
+
+    if (strcmp(spec, "front") == 0 || strcmp(spec, "back") == 0)
+    {
+        for (int i = 0; i < numRows; i++)
+        {
+            rows[count++] = (spec[0] == 'f') ? i : numRows - 1 - i;
+        }
+    }
+    else if (strcmp(spec, "middle") == 0)
+    {
+        // 10 rows: 4,5,3,6,2,7,1,8,0,9
+        int middle = (numRows - 1) / 2;
+        rows[count++] = middle;
+        for (int d = 1; d < numRows; d++)
+        {
+            if (middle + d < numRows)
+            {
+                rows[count++] = middle + d;
+            }
+            if (middle - d >= 0)
+            {
+                rows[count++] = middle - d;
+            }
+        }
+    }
+    else
+    {
+        const char *p = spec;
+        while (*p != '\0')
+        {
+            char *end;
+            long first = strtol(p, &end, 10);
+            long last = first;
+            if (end == p)
+            {
+                free(rows);
+                return 0;
+            }
+            if (*end == '-')
+            {
+                p = end + 1;
+                last = strtol(p, &end, 10);
+                if (end == p)
+                {
+                    free(rows);
+                    return 0;
+                }
+            }
+            if (first < 0 || first >= numRows || last < 0 || last >= numRows ||
+                count + labs(last - first) + 1 > numRows * 2)
+            {
+                free(rows);
+                return 0;
+            }
+
+            int step = (last >= first) ? 1 : -1;
+            for (long row = first; row != last + step; row += step)
+            {
+                rows[count++] = (int)row;
+            }
+
+            p = end;
+            if (*p == ',')
+            {
+                p++;
+            }
+            else if (*p != '\0')
+            {
+                free(rows);
+                return 0;
+            }
+        }
+    }
+
+    *order = rows;
+    *length = count;
+    return 1;
+}
+
+void freeVenue(Venue *venue)
+{
+    for (int t = 0; t < venue->numTiers; t++)
+    {
+        free(venue->tiers[t].rowOrder);
+    }
+    free(venue->sections);
+    free(venue->tiers);
+    free(venue->rowSeats);
+    free(venue->rowSection);
+    free(venue->rowFirstSeat);
+    free(venue->rowTiers);
+    memset(venue, 0, sizeof(Venue));
+}
+
+// Read a venue description; path is only used in error messages. Returns 0
+// (after printing why) if the description is invalid.
+int loadVenue(Venue *venue, FILE *file, const char *path)
+{
+    memset(venue, 0, sizeof(Venue));
+
+    // Row orders can only be resolved once every section is known
+    char (*rowSpecs)[256] = NULL;
+    int sectionCapacity = 0;
+    char *line = NULL;
+    size_t lineCapacity = 0;
+    int lineNumber = 0;
+    long venueSeats = 0;
+    int ok = 1;
+
+    while (ok && getline(&line, &lineCapacity, file) != -1)
+    {
+        lineNumber++;
+
+        char *tokens[MAX_TOKENS];
+        int count = tokenize(line, tokens);
+        if (count == 0)
+        {
+            continue;
+        }
+
+        if (strcmp(tokens[0], "section") == 0 && (count == 4 || count == 5))
+        {
+            int rows, seats, copies = 1;
+            if (!parseCount(tokens[2], &rows) || !parseCount(tokens[3], &seats) ||
+                (count == 5 && !parseCount(tokens[4], &copies)) ||
+                rows < 1 || seats < 1 || seats > MAX_ROW_SEATS || copies < 1 ||
+                strlen(tokens[1]) + 12 > MAX_NAME)
+            {
+                printf("Error: %s line %d: bad section (rows >= 1, 1-%d seats per row)\n",
+                       path, lineNumber, MAX_ROW_SEATS);
+                ok = 0;
+                break;
+            }
+
+            // Checked in long before anything is added up in int
+            long totalRows = venue->numRows + (long)rows * copies;
+            long totalSeats = venueSeats + (long)rows * seats * copies;
+            if (rows > MAX_VENUE_ROWS || copies > MAX_VENUE_ROWS || totalRows > MAX_VENUE_ROWS ||
+                totalSeats > MAX_VENUE_SEATS)
+            {
+                printf("Error: %s line %d: venue too large (at most %d rows and %d seats)\n",
+                       path, lineNumber, MAX_VENUE_ROWS, MAX_VENUE_SEATS);
+                ok = 0;
+                break;
+            }
+            venueSeats = totalSeats;
+
+            for (int c = 0; c < copies; c++)
+            {
+                if (venue->numSections == sectionCapacity)
+                {
+                    sectionCapacity = sectionCapacity ? sectionCapacity * 2 : 16;
+                    venue->sections = realloc(venue->sections, sizeof(Section) * sectionCapacity);
+                }
+
+                Section *section = &venue->sections[venue->numSections++];
+                if (count == 5)
+                {
+                    snprintf(section->name, MAX_NAME, "%s%d", tokens[1], c + 1);
+                }
+                else
+                {
+                    snprintf(section->name, MAX_NAME, "%s", tokens[1]);
+                }
+                section->firstRow = venue->numRows;
+                section->numRows = rows;
+                section->seatsPerRow = seats;
+                venue->numRows += rows;
+            }
+        }
+        else if (strcmp(tokens[0], "tier") == 0 && count == 6)
+        {
+            Tier tier;
+            memset(&tier, 0, sizeof(Tier));
+
+            if (strlen(tokens[1]) != 1 || !isalpha((unsigned char)tokens[1][0]) ||
+                strlen(tokens[2]) >= MAX_NAME || !parseCount(tokens[3], &tier.numSellers) ||
+                tier.numSellers < 1 || tier.numSellers > MAX_VENUE_SELLERS - venue->numSellers || sscanf(tokens[4], "%d-%d", &tier.minService, &tier.maxService) != 2 ||
+                tier.minService < 1 || tier.maxService < tier.minService || strlen(tokens[5]) >= 256)
+            {
+                printf("Error: %s line %d: bad tier (tier <letter> <name> <sellers> <min>-<max> <rows>,\n"
+                       "       at most %d sellers in all)\n", path, lineNumber, MAX_VENUE_SELLERS);
+                ok = 0;
+                break;
+            }
+            for (int t = 0; t < venue->numTiers; t++)
+            {
+                if (venue->tiers[t].letter == tokens[1][0])
+                {
+                    printf("Error: %s line %d: tier %c is defined twice\n", path, lineNumber, tokens[1][0]);
+                    ok = 0;
+                }
+            }
+            if (!ok)
+            {
+                break;
+            }
+
+            tier.letter = tokens[1][0];
+            strcpy(tier.name, tokens[2]);
+
+            venue->tiers = realloc(venue->tiers, sizeof(Tier) * (venue->numTiers + 1));
+            rowSpecs = realloc(rowSpecs, sizeof(*rowSpecs) * (venue->numTiers + 1));
+            strcpy(rowSpecs[venue->numTiers], tokens[5]);
+            venue->tiers[venue->numTiers++] = tier;
+            venue->numSellers += tier.numSellers;
+        }
+        else
+        {
+            printf("Error: %s line %d: expected a section or tier line\n", path, lineNumber);
+            ok = 0;
+        }
+    }
+    free(line);
+
+    if (ok && (venue->numSections == 0 || venue->numTiers == 0))
+    {
+        printf("Error: %s needs at least one section and one tier\n", path);
+        ok = 0;
+    }
+
+    for (int t = 0; ok && t < venue->numTiers; t++)
+    {
+        Tier *tier = &venue->tiers[t];
+        if (!parseRowOrder(rowSpecs[t], venue->numRows, &tier->rowOrder, &tier->rowOrderLength))
+        {
+            printf("Error: %s: tier %c has a bad row order %s (the venue has rows 0-%d)\n",
+                   path, tier->letter, rowSpecs[t], venue->numRows - 1);
+            ok = 0;
+        }
+    }
+    free(rowSpecs);
+
+    if (!ok)
+    {
+        freeVenue(venue);
+        return 0;
+    }
+
+    // Per-row lookups for the seat map
+    venue->rowSeats = malloc(sizeof(int) * venue->numRows);
+    venue->rowSection = malloc(sizeof(int) * venue->numRows);
+    venue->rowFirstSeat = malloc(sizeof(int) * venue->numRows);
+    for (int s = 0; s < venue->numSections; s++)
+    {
+        const Section *section = &venue->sections[s];
+        for (int r = section->firstRow; r < section->firstRow + section->numRows; r++)
+        {
+            venue->rowSeats[r] = section->seatsPerRow;
+            venue->rowSection[r] = s;
+            venue->rowFirstSeat[r] = venue->totalSeats;
+            venue->totalSeats += section->seatsPerRow;
+        }
+        if (section->seatsPerRow > venue->maxRowSeats)
+        {
+            venue->maxRowSeats = section->seatsPerRow;
+        }
+    }
+
+    // Which tiers sell from each row, and how many seats each tier can sell;
+    // tiers may share rows or keep to rows of their own
+    venue->rowTiers = calloc(venue->numRows, sizeof(uint64_t));
+    for (int t = 0; t < venue->numTiers; t++)
+    {
+        Tier *tier = &venue->tiers[t];
+        for (int i = 0; i < tier->rowOrderLength; i++)
+        {
+            int row = tier->rowOrder[i];
+            if (!(venue->rowTiers[row] & (1ULL << t))) // a row order may list a row twice
+            {
+                venue->rowTiers[row] |= 1ULL << t;
+                tier->numSeats += venue->rowSeats[row];
+            }
+        }
+    }
+
+    return 1;
+}
+
+int loadVenueFile(Venue *venue, const char *path)
+{
+    FILE *file = fopen(path, "r");
+    if (file == NULL)
+    {
+        printf("Error: cannot open venue file %s\n", path);
+        return 0;
+    }
+
+    int ok = loadVenue(venue, file, path);
+    fclose(file);
+    return ok;
+}
+
+int loadDefaultVenue(Venue *venue)
+{
+    FILE *file = fmemopen((void *)defaultVenue, strlen(defaultVenue), "r");
+    int ok = loadVenue(venue, file, "default venue");
+    fclose(file);
+    return ok;
+}
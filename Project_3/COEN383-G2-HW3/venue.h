@@ -0,0 +1,56 @@
+#ifndef VENUE_H
+#define VENUE_H
+
+#include <stdint.h>
+
+#define MAX_ROW_SEATS 64 // a row is one 64-bit occupancy word
+#define MAX_NAME 32
+
+// Limits on a venue file, so sizes derived from it stay well inside an int
+#define MAX_VENUE_ROWS 1000000
+#define MAX_VENUE_SEATS 10000000
+#define MAX_VENUE_SELLERS 10000
+
+// A block of identical rows. Rows are numbered across the whole venue, in
+// the order the sections are listed (section 0 holds the front rows).
+typedef struct
+{
+    char name[MAX_NAME];
+    int firstRow;    // venue row number of this section's first row
+    int numRows;
+    int seatsPerRow; // 1-64
+} Section;
+
+// A price tier: its sellers, how long their sales take and the order in
+// which they look through the rows for a free seat
+typedef struct
+{
+    char letter;           // 'H', 'M', 'L', ... starts every seller and customer ID of the tier
+    char name[MAX_NAME];   // e.g. "High-Price"
+    int numSellers;
+    int minService;        // service time of a sale, minutes (uniform in min..max)
+    int maxService;
+    int *rowOrder;         // venue rows to search, best first
+    int rowOrderLength;
+    int numSeats;          // seats in the rows it sells from, derived when loading
+} Tier;
+
+typedef struct
+{
+    Section *sections;
+    int numSections;
+    Tier *tiers;
+    int numTiers;
+
+    // Derived when loading
+    int numRows;
+    int *rowSeats;     // seats in each row
+    int *rowSection;   // section of each row
+    int *rowFirstSeat; // venue seat number of each row's seat 0
+    uint64_t *rowTiers; // bit t of a row is set if tier t sells from it (one tier per letter, so at most 52)
+    int maxRowSeats;
+    int totalSeats;
+    int numSellers;    // over all tiers
+} Venue;
+
+#endif
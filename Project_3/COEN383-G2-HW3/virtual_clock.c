@@ -0,0 +1,60 @@
+#include <pthread.h>
+
+// Virtual clock for the fast mode: instead of a wall-clock tick every 50ms,
+// a minute ends as soon as every seller has finished its work for it. The
+// last seller to finish runs the end-of-minute check and moves the clock on,
+// then all sellers continue with the new minute. Threads only meet here once
+// per simulated minute, so an hour takes a millisecond or so.
+typedef struct
+{
+    pthread_mutex_t lock;
+    pthread_cond_t tick;
+    int parties;    // seller threads taking part
+    int waiting;    // sellers done with the current minute
+    int generation; // bumped every time the clock moves, so waiters know they may go
+    int now;        // current minute, only changed by the last seller to arrive
+} VirtualClock;
+
+void clockInit(VirtualClock *clock, int parties)
+{
+    pthread_mutex_init(&clock->lock, NULL);
+    pthread_cond_init(&clock->tick, NULL);
+    clock->parties = parties;
+    clock->waiting = 0;
+    clock->generation = 0;
+    clock->now = 0;
+}
+
+void clockDestroy(VirtualClock *clock)
+{
+    pthread_mutex_destroy(&clock->lock);
+    pthread_cond_destroy(&clock->tick);
+}
+
+// Called by each seller when it is done with the current minute. The last one
+// in calls endMinute(arg, now), which returns the next minute, and wakes the
+// rest. Returns the new minute.
+int clockAdvance(VirtualClock *clock, int (*endMinute)(void *arg, int now), void *arg)
+{
+    pthread_mutex_lock(&clock->lock);
+
+    int generation = clock->generation;
+    if (++clock->waiting == clock->parties)
+    {
+        clock->now = endMinute(arg, clock->now);
+        clock->waiting = 0;
+        clock->generation++;
+        pthread_cond_broadcast(&clock->tick);
+    }
+    else
+    {
+        while (generation == clock->generation)
+        {
+            pthread_cond_wait(&clock->tick, &clock->lock);
+        }
+    }
+
+    int now = clock->now;
+    pthread_mutex_unlock(&clock->lock);
+    return now;
+}
@@ -5,6 +5,7 @@
 #include <time.h>
 #include "process.h"
 #include "process_utils.h"
+#include "rng.h"
 #include "simulation_utils.h"
 
 #define MIN_FREE_PAGES 4
@@ -36,22 +37,22 @@ PageFrame memory[TOTAL_PAGES];
 int free_page_count = TOTAL_PAGES;
 
 // Function prototypes
-int get_next_page(int current_page, int process_size);
-int find_victim_page(ReplacementAlgo algo, double current_time);
+int get_next_page(int current_page, int process_size, Rng *rng);
+int find_victim_page(ReplacementAlgo algo, double current_time, Rng *rng);
 void print_memory_map(Process processes[], int num_processes);
-void simulate(Process processes[], ReplacementAlgo algo, Statistics *stats, int run_num, int print_details);
+void simulate(Process processes[], ReplacementAlgo algo, Statistics *stats, int run_num, int print_details, Rng *rng);
 int allocate_initial_page(Process *proc, int proc_id);
 void deallocate_process_pages(Process *proc);
 
 // Get next page reference based on locality of reference
-int get_next_page(int current_page, int process_size)
+int get_next_page(int current_page, int process_size, Rng *rng)
 {
-    int r = rand() % 11; // 0 to 10
+    int r = rng_below(rng, 11); // 0 to 10
     int next_page;
 
     if (r < 7)
     { // 70% probability: delta = -1, 0, or +1
-        int delta = (rand() % 3) - 1; // -1, 0, or 1
+        int delta = (int)rng_below(rng, 3) - 1; // -1, 0, or 1
         next_page = current_page + delta;
 
         // Wrap around
@@ -77,7 +78,7 @@ int get_next_page(int current_page, int process_size)
 
         if (count > 0)
         {
-            next_page = valid_pages[rand() % count];
+            next_page = valid_pages[rng_below(rng, count)];
         }
         else
         {
@@ -89,7 +90,7 @@ int get_next_page(int current_page, int process_size)
 }
 
 // Find victim page to evict based on replacement algorithm
-int find_victim_page(ReplacementAlgo algo, double current_time)
+int find_victim_page(ReplacementAlgo algo, double current_time, Rng *rng)
 {
     int victim = -1;
 
@@ -165,7 +166,7 @@ int find_victim_page(ReplacementAlgo algo, double current_time)
         }
         if (count > 0)
         {
-            victim = occupied[rand() % count];
+            victim = occupied[rng_below(rng, count)];
         }
         break;
     }
@@ -255,7 +256,7 @@ void deallocate_process_pages(Process *proc)
 }
 
 // Main simulation function
-void simulate(Process processes[], ReplacementAlgo algo, Statistics *stats, int run_num, int print_details)
+void simulate(Process processes[], ReplacementAlgo algo, Statistics *stats, int run_num, int print_details, Rng *rng)
 {
     // Initialize memory
     for (int i = 0; i < TOTAL_PAGES; i++)
@@ -337,7 +338,7 @@ void simulate(Process processes[], ReplacementAlgo algo, Statistics *stats, int
             // Generate memory reference every 100ms
             if (fmod(current_time - proc->start_time, REFERENCE_INTERVAL) < 0.01)
             {
-                int next_page = get_next_page(proc->currentPage, proc->size_pages);
+                int next_page = get_next_page(proc->currentPage, proc->size_pages, rng);
                 proc->currentPage = next_page;
 
                 // Check if page is in memory
@@ -380,7 +381,7 @@ void simulate(Process processes[], ReplacementAlgo algo, Statistics *stats, int
                     // If no free frame, evict a page
                     if (victim_frame == -1)
                     {
-                        victim_frame = find_victim_page(algo, current_time);
+                        victim_frame = find_victim_page(algo, current_time, rng);
                         if (victim_frame != -1)
                         {
                             victim_proc_id = memory[victim_frame].process_id;
@@ -451,7 +452,12 @@ int main()
         for (int run = 0; run < NUM_RUNS; run++)
         {
             Process processes[NUM_PROCESSES];
-            generate_processes(processes, 1000 + run * 100 + algo * 500);
+            int seed = 1000 + run * 100 + algo * 500;
+            generate_processes(processes, seed);
+
+            // Memory references come from their own stream of the same seed
+            Rng rng;
+            rng_stream(&rng, seed, 1);
 
             Statistics stats;
             int print_details = (run == 0 && algo == FIFO); // Print details for first run of FIFO
@@ -463,7 +469,7 @@ int main()
                 printf("------------------------------------------------\n");
             }
 
-            simulate(processes, algo, &stats, run, print_details);
+            simulate(processes, algo, &stats, run, print_details, &rng);
 
             total_hits += stats.hits;
             total_misses += stats.misses;
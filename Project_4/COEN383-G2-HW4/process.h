@@ -33,3 +33,5 @@ typedef struct PageFrame
 void generate_processes(Process processes[], int count);
 void print_processes(Process processes[], int num_processes);
 FreePageNode *init_free_list(int num_frames);
+
+#endif
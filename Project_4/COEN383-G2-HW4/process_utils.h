@@ -3,11 +3,13 @@
 #include <string.h>
 #include <math.h>
 #include "process.h"
+#include "rng.h"
 #include "simulation_utils.h"
 
 void generate_processes(Process processes[], int seed)
 {
-    srand(seed); // each of the 5 runs uses a different seed
+    Rng rng;
+    rng_stream(&rng, seed, 0); // each of the 5 runs uses a different seed; stream 1 drives the references
 
     int sizes[] = {5, 11, 17, 31};
 
@@ -16,11 +18,11 @@ void generate_processes(Process processes[], int seed)
         processes[i].id = i;
         sprintf(processes[i].name, "P%d", i);
 
-        processes[i].size_pages = sizes[rand() % 4];
+        processes[i].size_pages = sizes[rng_below(&rng, 4)];
 
         // Generate float values
-        processes[i].arrival_time = ((double)rand() / RAND_MAX) * 60.0; //  random double in [0, 60)
-        processes[i].service_time = (rand() % 5) + 1;                   // random int from {1, 2, 3, 4, 5}
+        processes[i].arrival_time = rng_double(&rng) * 60.0; //  random double in [0, 60)
+        processes[i].service_time = rng_below(&rng, 5) + 1;                 // random int from {1, 2, 3, 4, 5}
         processes[i].start_time = -1.0;
         processes[i].currentPage = 0;
         processes[i].pages_in_memory = 0;